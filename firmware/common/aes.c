@@ -31,6 +31,11 @@
 
 #include "aes.h"
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 static inline uint32_t br_dec32le(const unsigned char *src) {
     return (uint32_t)src[0]
            | ((uint32_t)src[1] << 8)
@@ -65,6 +70,7 @@ static void br_range_enc32le(unsigned char *dst, const uint32_t *v, size_t num)
     }
 }
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
 static void br_aes_ct64_bitslice_Sbox(uint64_t *q) {
     /*
      * This S-box implementation is a straightforward translation of
@@ -316,11 +322,14 @@ static void br_aes_ct64_interleave_out(uint32_t *w, uint64_t q0, uint64_t q1) {
     w[3] = (uint32_t)x3 | (uint32_t)(x3 >> 16);
 }
 
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 static const unsigned char Rcon[] = {
     0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36
 };
 
 static uint32_t sub_word(uint32_t x) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     uint64_t q[8];
 
     memset(q, 0, sizeof q);
@@ -329,12 +338,21 @@ static uint32_t sub_word(uint32_t x) {
     br_aes_ct64_bitslice_Sbox(q);
     br_aes_ct64_ortho(q);
     return (uint32_t)q[0];
+#else
+    uint32_t r = 0;
+
+    PICORV32_AES32ESI(r, r, x, 0);
+    PICORV32_AES32ESI(r, r, x, 1);
+    PICORV32_AES32ESI(r, r, x, 2);
+    PICORV32_AES32ESI(r, r, x, 3);
+    return r;
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
-static void br_aes_ct64_keysched(uint64_t *comp_skey, const unsigned char *key, unsigned int key_len) {
+/* Expands the key into (nrounds + 1) * 4 round key words */
+static void aes_keysched_words(uint32_t *skey, const unsigned char *key, unsigned int key_len) {
     unsigned int i, j, k, nk, nkf;
     uint32_t tmp;
-    uint32_t skey[60];
     unsigned nrounds = 10 + ((key_len - 16) >> 2);
 
     nk = (key_len >> 2);
@@ -355,6 +373,16 @@ static void br_aes_ct64_keysched(uint64_t *comp_skey, const unsigned char *key,
             k ++;
         }
     }
+}
+
+#ifdef DISABLE_CUSTOM_INSTRUCTION
+static void br_aes_ct64_keysched(uint64_t *comp_skey, const unsigned char *key, unsigned int key_len) {
+    unsigned int i, j, nkf;
+    uint32_t skey[60];
+    unsigned nrounds = 10 + ((key_len - 16) >> 2);
+
+    nkf = ((nrounds + 1) << 2);
+    aes_keysched_words(skey, key, key_len);
 
     for (i = 0, j = 0; i < nkf; i += 4, j += 2) {
         uint64_t q[8];
@@ -402,6 +430,13 @@ static void br_aes_ct64_skey_expand(uint64_t *skey, const uint64_t *comp_skey, u
     }
 }
 
+static void aes_keyexp(uint64_t *sk_exp, const unsigned char *key, unsigned int key_len) {
+    uint64_t skey[30];
+
+    br_aes_ct64_keysched(skey, key, key_len);
+    br_aes_ct64_skey_expand(sk_exp, skey, 10 + ((key_len - 16) >> 2));
+}
+
 static inline void add_round_key(uint64_t *q, const uint64_t *sk) {
     q[0] ^= sk[0];
     q[1] ^= sk[1];
@@ -555,17 +590,99 @@ static void aes_ctr(unsigned char *out, size_t outlen, const unsigned char *iv,
         }
     }
 }
+#else
+/*
+ * With the aes32 instructions the expanded key is kept as plain 32-bit
+ * round key words in sk_exp and blocks are encrypted one at a time, one
+ * aes32esmi per state byte (aes32esi in the final round).
+ */
+static void aes_keyexp(uint64_t *sk_exp, const unsigned char *key, unsigned int key_len) {
+    aes_keysched_words((uint32_t *)sk_exp, key, key_len);
+}
+
+#define AES32_ROUND(insn, t, s, rk)                 \
+    do {                                            \
+        (t)[0] = (rk)[0];                           \
+        (t)[1] = (rk)[1];                           \
+        (t)[2] = (rk)[2];                           \
+        (t)[3] = (rk)[3];                           \
+        insn((t)[0], (t)[0], (s)[0], 0);            \
+        insn((t)[0], (t)[0], (s)[1], 1);            \
+        insn((t)[0], (t)[0], (s)[2], 2);            \
+        insn((t)[0], (t)[0], (s)[3], 3);            \
+        insn((t)[1], (t)[1], (s)[1], 0);            \
+        insn((t)[1], (t)[1], (s)[2], 1);            \
+        insn((t)[1], (t)[1], (s)[3], 2);            \
+        insn((t)[1], (t)[1], (s)[0], 3);            \
+        insn((t)[2], (t)[2], (s)[2], 0);            \
+        insn((t)[2], (t)[2], (s)[3], 1);            \
+        insn((t)[2], (t)[2], (s)[0], 2);            \
+        insn((t)[2], (t)[2], (s)[1], 3);            \
+        insn((t)[3], (t)[3], (s)[3], 0);            \
+        insn((t)[3], (t)[3], (s)[0], 1);            \
+        insn((t)[3], (t)[3], (s)[1], 2);            \
+        insn((t)[3], (t)[3], (s)[2], 3);            \
+    } while (0)
 
-void aes128_ecb_keyexp(aes128ctx *r, const unsigned char *key) {
-    uint64_t skey[22];
+static void aes_encrypt_block(unsigned char out[16], const uint32_t in[4], const uint32_t *rk, unsigned int nrounds) {
+    uint32_t s[4], t[4];
+    unsigned int i;
 
+    s[0] = in[0] ^ rk[0];
+    s[1] = in[1] ^ rk[1];
+    s[2] = in[2] ^ rk[2];
+    s[3] = in[3] ^ rk[3];
+    for (i = 1; i < nrounds; i++) {
+        AES32_ROUND(PICORV32_AES32ESMI, t, s, rk + (i << 2));
+        memcpy(s, t, sizeof(s));
+    }
+    AES32_ROUND(PICORV32_AES32ESI, t, s, rk + (nrounds << 2));
+    br_range_enc32le(out, t, 4);
+}
+
+static void aes_ecb(unsigned char *out, const unsigned char *in, size_t nblocks, const uint64_t *rkeys, unsigned int nrounds) {
+    uint32_t block[4];
+
+    while (nblocks > 0) {
+        br_range_dec32le(block, 4, in);
+        aes_encrypt_block(out, block, (const uint32_t *)rkeys, nrounds);
+        nblocks--;
+        in += 16;
+        out += 16;
+    }
+}
+
+static void aes_ctr(unsigned char *out, size_t outlen, const unsigned char *iv, const uint64_t *rkeys, unsigned int nrounds) {
+    uint32_t ivw[4];
+    size_t i;
+    uint32_t cc = 0;
+    unsigned char tmp[16];
+
+    br_range_dec32le(ivw, 3, iv);
+    ivw[3] = br_swap32(cc);
+
+    while (outlen > 16) {
+        aes_encrypt_block(out, ivw, (const uint32_t *)rkeys, nrounds);
+        ivw[3] = br_swap32(++cc);
+        out += 16;
+        outlen -= 16;
+    }
+    if (outlen > 0) {
+        aes_encrypt_block(tmp, ivw, (const uint32_t *)rkeys, nrounds);
+        for (i = 0; i < outlen; i++) {
+            out[i] = tmp[i];
+        }
+    }
+}
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+void aes128_ecb_keyexp(aes128ctx *r, const unsigned char *key) {
     r->sk_exp = malloc(sizeof(uint64_t) * PQC_AES128_STATESIZE);
     if (r->sk_exp == NULL) {
         exit(111);
     }
 
-    br_aes_ct64_keysched(skey, key, 16);
-    br_aes_ct64_skey_expand(r->sk_exp, skey, 10);
+    aes_keyexp(r->sk_exp, key, 16);
 }
 
 void aes128_ctr_keyexp(aes128ctx *r, const unsigned char *key) {
@@ -573,14 +690,12 @@ void aes128_ctr_keyexp(aes128ctx *r, const unsigned char *key) {
 }
 
 void aes192_ecb_keyexp(aes192ctx *r, const unsigned char *key) {
-    uint64_t skey[26];
     r->sk_exp = malloc(sizeof(uint64_t) * PQC_AES192_STATESIZE);
     if (r->sk_exp == NULL) {
         exit(111);
     }
 
-    br_aes_ct64_keysched(skey, key, 24);
-    br_aes_ct64_skey_expand(r->sk_exp, skey, 12);
+    aes_keyexp(r->sk_exp, key, 24);
 }
 
 void aes192_ctr_keyexp(aes192ctx *r, const unsigned char *key) {
@@ -588,14 +703,12 @@ void aes192_ctr_keyexp(aes192ctx *r, const unsigned char *key) {
 }
 
 void aes256_ecb_keyexp(aes256ctx *r, const unsigned char *key) {
-    uint64_t skey[30];
     r->sk_exp = malloc(sizeof(uint64_t) * PQC_AES256_STATESIZE);
     if (r->sk_exp == NULL) {
         exit(111);
     }
 
-    br_aes_ct64_keysched(skey, key, 32);
-    br_aes_ct64_skey_expand(r->sk_exp, skey, 14);
+    aes_keyexp(r->sk_exp, key, 32);
 }
 
 void aes256_ctr_keyexp(aes256ctx *r, const unsigned char *key) {
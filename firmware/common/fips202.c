@@ -12,9 +12,102 @@
 
 #include "fips202.h"
 
+//#define ENABLE_KECCAK_COPROCESSOR
+
 #define NROUNDS 24
 #define ROL(a, offset) (((a) << (offset)) ^ ((a) >> (64 - (offset))))
 
+#ifdef ENABLE_KECCAK_COPROCESSOR
+/* Keccak-f[1600] engine, see picosoc/keccakf1600.v. Reads return the state,
+ * writes XOR into the state; any access waits for a running permutation. */
+#define KECCAK_BASE         0x03001000
+#define KECCAK_STATE        ((volatile uint32_t *)KECCAK_BASE)
+#define KECCAK_STATE8       ((volatile uint8_t *)KECCAK_BASE)
+#define KECCAK_CTRL         (*(volatile uint32_t *)(KECCAK_BASE + 0xc8))
+#define KECCAK_CTRL_START   1
+#define KECCAK_CTRL_CLEAR   2
+
+/*************************************************
+ * Name:        keccak_hw_load
+ *
+ * Description: Copy a Keccak state into the engine
+ *
+ * Arguments:   - const uint64_t *s: pointer to input Keccak state
+ **************************************************/
+static void keccak_hw_load(const uint64_t *s) {
+    KECCAK_CTRL = KECCAK_CTRL_CLEAR;
+    for (size_t i = 0; i < 25; ++i) {
+        KECCAK_STATE[2 * i] = (uint32_t)s[i];
+        KECCAK_STATE[2 * i + 1] = (uint32_t)(s[i] >> 32);
+    }
+}
+
+/*************************************************
+ * Name:        keccak_hw_store
+ *
+ * Description: Copy the Keccak state out of the engine
+ *
+ * Arguments:   - uint64_t *s: pointer to output Keccak state
+ **************************************************/
+static void keccak_hw_store(uint64_t *s) {
+    for (size_t i = 0; i < 25; ++i) {
+        s[i] = KECCAK_STATE[2 * i] | (uint64_t)KECCAK_STATE[2 * i + 1] << 32;
+    }
+}
+
+/*************************************************
+ * Name:        keccak_hw_xor
+ *
+ * Description: XOR bytes into the state of the engine
+ *
+ * Arguments:   - const uint8_t *m: pointer to input bytes
+ *              - size_t pos: byte offset into the state
+ *              - size_t len: number of bytes
+ **************************************************/
+static void keccak_hw_xor(const uint8_t *m, size_t pos, size_t len) {
+    for (; len > 0 && (pos & 3); len--) {
+        KECCAK_STATE8[pos++] = *m++;
+    }
+    for (; len >= 4; len -= 4) {
+        KECCAK_STATE[pos >> 2] = (uint32_t)m[0] | (uint32_t)m[1] << 8 |
+                                 (uint32_t)m[2] << 16 | (uint32_t)m[3] << 24;
+        pos += 4;
+        m += 4;
+    }
+    for (; len > 0; len--) {
+        KECCAK_STATE8[pos++] = *m++;
+    }
+}
+
+/*************************************************
+ * Name:        keccak_hw_extract
+ *
+ * Description: Read bytes from the state of the engine
+ *
+ * Arguments:   - uint8_t *h: pointer to output bytes
+ *              - size_t pos: byte offset into the state
+ *              - size_t len: number of bytes
+ **************************************************/
+static void keccak_hw_extract(uint8_t *h, size_t pos, size_t len) {
+    uint32_t w;
+
+    for (; len > 0 && (pos & 3); len--) {
+        *h++ = KECCAK_STATE8[pos++];
+    }
+    for (; len >= 4; len -= 4) {
+        w = KECCAK_STATE[pos >> 2];
+        h[0] = (uint8_t)w;
+        h[1] = (uint8_t)(w >> 8);
+        h[2] = (uint8_t)(w >> 16);
+        h[3] = (uint8_t)(w >> 24);
+        pos += 4;
+        h += 4;
+    }
+    for (; len > 0; len--) {
+        *h++ = KECCAK_STATE8[pos++];
+    }
+}
+#else
 /*************************************************
  * Name:        load64
  *
@@ -332,6 +425,7 @@ static void KeccakF1600_StatePermute(uint64_t *state) {
     state[23] = Aso;
     state[24] = Asu;
 }
+#endif // ENABLE_KECCAK_COPROCESSOR
 
 /*************************************************
  * Name:        keccak_absorb
@@ -348,6 +442,21 @@ static void KeccakF1600_StatePermute(uint64_t *state) {
  **************************************************/
 static void keccak_absorb(uint64_t *s, uint32_t r, const uint8_t *m,
                           size_t mlen, uint8_t p) {
+#ifdef ENABLE_KECCAK_COPROCESSOR
+    KECCAK_CTRL = KECCAK_CTRL_CLEAR;
+
+    while (mlen >= r) {
+        keccak_hw_xor(m, 0, r);
+        KECCAK_CTRL = KECCAK_CTRL_START;
+        mlen -= r;
+        m += r;
+    }
+
+    keccak_hw_xor(m, 0, mlen);
+    KECCAK_STATE8[mlen] = p;
+    KECCAK_STATE8[r - 1] = 128;
+    keccak_hw_store(s);
+#else
     size_t i;
     uint8_t t[200];
 
@@ -377,6 +486,7 @@ static void keccak_absorb(uint64_t *s, uint32_t r, const uint8_t *m,
     for (i = 0; i < r / 8; ++i) {
         s[i] ^= load64(t + 8 * i);
     }
+#endif // ENABLE_KECCAK_COPROCESSOR
 }
 
 /*************************************************
@@ -394,6 +504,16 @@ static void keccak_absorb(uint64_t *s, uint32_t r, const uint8_t *m,
  **************************************************/
 static void keccak_squeezeblocks(uint8_t *h, size_t nblocks,
                                  uint64_t *s, uint32_t r) {
+#ifdef ENABLE_KECCAK_COPROCESSOR
+    keccak_hw_load(s);
+    while (nblocks > 0) {
+        KECCAK_CTRL = KECCAK_CTRL_START;
+        keccak_hw_extract(h, 0, r);
+        h += r;
+        nblocks--;
+    }
+    keccak_hw_store(s);
+#else
     while (nblocks > 0) {
         KeccakF1600_StatePermute(s);
         for (size_t i = 0; i < (r >> 3); i++) {
@@ -402,6 +522,7 @@ static void keccak_squeezeblocks(uint8_t *h, size_t nblocks,
         h += r;
         nblocks--;
     }
+#endif // ENABLE_KECCAK_COPROCESSOR
 }
 
 /*************************************************
@@ -442,6 +563,21 @@ static void keccak_inc_absorb(uint64_t *s_inc, uint32_t r, const uint8_t *m,
     size_t i;
 
     /* Recall that s_inc[25] is the non-absorbed bytes xored into the state */
+#ifdef ENABLE_KECCAK_COPROCESSOR
+    /* Only move the state into the engine if a permutation is needed */
+    if (mlen + s_inc[25] >= r) {
+        keccak_hw_load(s_inc);
+        do {
+            keccak_hw_xor(m, (size_t)s_inc[25], r - (size_t)s_inc[25]);
+            mlen -= (size_t)(r - s_inc[25]);
+            m += r - s_inc[25];
+            s_inc[25] = 0;
+
+            KECCAK_CTRL = KECCAK_CTRL_START;
+        } while (mlen >= r);
+        keccak_hw_store(s_inc);
+    }
+#else
     while (mlen + s_inc[25] >= r) {
         for (i = 0; i < r - (uint32_t)s_inc[25]; i++) {
             /* Take the i'th byte from message
@@ -454,6 +590,7 @@ static void keccak_inc_absorb(uint64_t *s_inc, uint32_t r, const uint8_t *m,
 
         KeccakF1600_StatePermute(s_inc);
     }
+#endif // ENABLE_KECCAK_COPROCESSOR
 
     for (i = 0; i < mlen; i++) {
         s_inc[(s_inc[25] + i) >> 3] ^= (uint64_t)m[i] << (8 * ((s_inc[25] + i) & 0x07));
@@ -510,6 +647,21 @@ static void keccak_inc_squeeze(uint8_t *h, size_t outlen,
     s_inc[25] -= i;
 
     /* Then squeeze the remaining necessary blocks */
+#ifdef ENABLE_KECCAK_COPROCESSOR
+    if (outlen > 0) {
+        keccak_hw_load(s_inc);
+        while (outlen > 0) {
+            KECCAK_CTRL = KECCAK_CTRL_START;
+
+            i = outlen < r ? outlen : r;
+            keccak_hw_extract(h, 0, i);
+            h += i;
+            outlen -= i;
+            s_inc[25] = r - i;
+        }
+        keccak_hw_store(s_inc);
+    }
+#else
     while (outlen > 0) {
         KeccakF1600_StatePermute(s_inc);
 
@@ -520,6 +672,7 @@ static void keccak_inc_squeeze(uint8_t *h, size_t outlen,
         outlen -= i;
         s_inc[25] = r - i;
     }
+#endif // ENABLE_KECCAK_COPROCESSOR
 }
 
 void shake128_inc_init(shake128incctx *state) {
@@ -0,0 +1,80 @@
+#ifndef NTT_ENGINE_H
+#define NTT_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* NTT engine, see picosoc/ntt_engine.v. The engine holds three polynomials
+ * and the twiddle factors of the scheme in local RAM. Starting an operation
+ * returns immediately; the next access to the engine waits until it is done,
+ * so the CPU can do other work (e.g. SHAKE) in between. */
+#define NTT_ENGINE_BASE             0x03002000
+#define NTT_ENGINE_POLY(n)          ((volatile int32_t *)(NTT_ENGINE_BASE + 0x400 * (n)))
+#define NTT_ENGINE_ZETAS            ((volatile int32_t *)(NTT_ENGINE_BASE + 0xc00))
+#define NTT_ENGINE_CTRL             (*(volatile uint32_t *)(NTT_ENGINE_BASE + 0x1000))
+#define NTT_ENGINE_MODE             (*(volatile uint32_t *)(NTT_ENGINE_BASE + 0x1004))
+
+#define NTT_ENGINE_OP_NTT           1
+#define NTT_ENGINE_OP_INVNTT        2
+#define NTT_ENGINE_OP_MUL           3   // poly 2 = poly 0 * poly 1
+#define NTT_ENGINE_OP_MAC           4   // poly 2 += poly 0 * poly 1
+#define NTT_ENGINE_OP_REDUCE        5
+
+#define NTT_ENGINE_MODE_KYBER       0
+#define NTT_ENGINE_MODE_DILITHIUM   1
+
+/* Start operation op on polynomial n (n is ignored by MUL and MAC) */
+static inline void ntt_engine_start(unsigned int op, unsigned int n) {
+    NTT_ENGINE_CTRL = op | n << 4;
+}
+
+/* Wait for the running operation */
+static inline void ntt_engine_wait(void) {
+    (void)NTT_ENGINE_CTRL;
+}
+
+/* Select the scheme and load its zetas table */
+static inline void ntt_engine_setup16(const int16_t *zetas, size_t len) {
+    NTT_ENGINE_MODE = NTT_ENGINE_MODE_KYBER;
+    for (size_t i = 0; i < len; i++) {
+        NTT_ENGINE_ZETAS[i] = zetas[i];
+    }
+}
+
+static inline void ntt_engine_setup32(const int32_t *zetas, size_t len) {
+    NTT_ENGINE_MODE = NTT_ENGINE_MODE_DILITHIUM;
+    for (size_t i = 0; i < len; i++) {
+        NTT_ENGINE_ZETAS[i] = zetas[i];
+    }
+}
+
+/* Copy coefficients into / out of polynomial n of the engine */
+static inline void ntt_engine_load16(unsigned int n, const int16_t *a, size_t len) {
+    volatile int32_t *p = NTT_ENGINE_POLY(n);
+    for (size_t i = 0; i < len; i++) {
+        p[i] = a[i];
+    }
+}
+
+static inline void ntt_engine_store16(int16_t *a, unsigned int n, size_t len) {
+    volatile int32_t *p = NTT_ENGINE_POLY(n);
+    for (size_t i = 0; i < len; i++) {
+        a[i] = (int16_t)p[i];
+    }
+}
+
+static inline void ntt_engine_load32(unsigned int n, const int32_t *a, size_t len) {
+    volatile int32_t *p = NTT_ENGINE_POLY(n);
+    for (size_t i = 0; i < len; i++) {
+        p[i] = a[i];
+    }
+}
+
+static inline void ntt_engine_store32(int32_t *a, unsigned int n, size_t len) {
+    volatile int32_t *p = NTT_ENGINE_POLY(n);
+    for (size_t i = 0; i < len; i++) {
+        a[i] = p[i];
+    }
+}
+
+#endif
@@ -0,0 +1,695 @@
+#ifndef PICORV32_INSN_H
+#define PICORV32_INSN_H
+
+#include <stdint.h>
+
+/* Wrappers for the PicoRV32 custom instructions used by the PQC firmware.
+ *
+ * All instructions are R-type instructions in the custom-1 opcode space
+ * (0101011), except for the clmul*, aes32* and sha* instructions which use
+ * the standard scalar crypto (Zbkc, Zkne/Zknd, Zknh) encodings in the OP and
+ * OP-IMM opcode spaces, the Zbp bit permutations which use the bitmanip
+ * encodings in the OP and OP-IMM opcode spaces, and the packed 16-bit SIMD
+ * instructions which use the P extension encodings in the OP-P opcode
+ * space (1110111).
+ * They are emitted with the .insn directive, so a stock GNU assembler is
+ * sufficient; see the "Custom Instructions for Cryptography" section of the
+ * top-level README.md for the encodings and the Verilog parameters that
+ * enable them.
+ */
+
+#define PICORV32_INSN_R(f3, f7, rd, rs1, rs2) \
+    __asm__ (".insn r 0x2b, " #f3 ", " #f7 ", %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2))
+
+/* Same for the standard extensions in the OP opcode space (0110011) */
+#define PICORV32_INSN_OP(f3, f7, rd, rs1, rs2) \
+    __asm__ (".insn r 0x33, " #f3 ", " #f7 ", %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2))
+
+/* Same for the packed SIMD instructions in the OP-P opcode space (1110111) */
+#define PICORV32_INSN_P(f3, f7, rd, rs1, rs2) \
+    __asm__ (".insn r 0x77, " #f3 ", " #f7 ", %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2))
+
+/* Instructions for the accelerator slots of picorv32_pcpi_custom, in the
+ * custom-0 (0001011) and custom-1 opcode spaces. The R4 forms pass a third
+ * source register in insn[31:27] and a 2-bit funct2 in insn[26:25]. */
+#define PICORV32_INSN_CUSTOM0(f3, f7, rd, rs1, rs2) \
+    __asm__ volatile (".insn r 0x0b, " #f3 ", " #f7 ", %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2))
+#define PICORV32_INSN_CUSTOM1(f3, f7, rd, rs1, rs2) \
+    __asm__ volatile (".insn r 0x2b, " #f3 ", " #f7 ", %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2))
+#define PICORV32_INSN_CUSTOM0_R4(f3, f2, rd, rs1, rs2, rs3) \
+    __asm__ volatile (".insn r4 0x0b, " #f3 ", " #f2 ", %0, %1, %2, %3" : "=r"(rd) : "r"(rs1), "r"(rs2), "r"(rs3))
+#define PICORV32_INSN_CUSTOM1_R4(f3, f2, rd, rs1, rs2, rs3) \
+    __asm__ volatile (".insn r4 0x2b, " #f3 ", " #f2 ", %0, %1, %2, %3" : "=r"(rd) : "r"(rs1), "r"(rs2), "r"(rs3))
+
+/* Hardware loop (ENABLE_HWLOOP), for use inside an asm statement.
+ * PICORV32_HWLOOP_BEGIN emits lp.setup (custom-3 opcode, 1111011): the n
+ * instructions that follow it are executed count times, count being a
+ * register operand such as "%[len]". The body is assembled without compressed
+ * instructions, so that it is 4 * n bytes long, and must be closed with
+ * PICORV32_HWLOOP_END. Its last instruction must not be a branch or jump. */
+#define PICORV32_HWLOOP_BEGIN(count, n) \
+    ".option push\n\t.option norvc\n\t.insn i 0x7b, 4, x0, " count ", 2 * " #n " + 2\n\t"
+#define PICORV32_HWLOOP_END \
+    ".option pop\n\t"
+
+/* Number of mispredicted conditional branches since reset (ENABLE_BTFN and
+ * ENABLE_COUNTERS), from csr 0xc03 (hpmcounter3) */
+static inline uint32_t picorv32_rdbmiss(void) {
+    uint32_t r;
+    __asm__ volatile ("csrr %0, 0xc03" : "=r"(r));
+    return r;
+}
+
+/* Performance monitoring counters (HPM_EVENTS). PICORV32_RDHPM reads the
+ * counter of event into rd, from csr 0xc04 + event. */
+#define PICORV32_HPM_FETCH_STALL    0
+#define PICORV32_HPM_MEM            1
+#define PICORV32_HPM_BRANCH         2
+#define PICORV32_HPM_PCPI_WAIT      3
+#define PICORV32_HPM_CUSTOM         4
+#define PICORV32_HPM_IRQ_LATENCY    5
+
+#define PICORV32_RDHPM(rd, event) \
+    __asm__ volatile ("csrr %0, %1" : "=r"(rd) : "i"(0xc04 + (event)))
+
+/* Pack two int16_t coefficients into one register, lo in bits 15:0 */
+static inline uint32_t picorv32_pack16(int16_t lo, int16_t hi) {
+    return (uint32_t)(uint16_t)lo | ((uint32_t)(uint16_t)hi << 16);
+}
+
+/* Two packed int16_t coefficients, for word accesses to int16_t arrays.
+ * The array must be 4-byte aligned. */
+typedef uint32_t __attribute__((__may_alias__)) picorv32_v2i16;
+
+/*************************************************
+* Name:        picorv32_kyber_mont
+*
+* Description: Kyber Montgomery reduction (ENABLE_KYBER_MONT)
+*
+* Arguments:   - int32_t a: input integer, in {-q2^15,...,q2^15-1}
+*
+* Returns a * 2^{-16} (mod q) in {-q+1,...,q-1}
+**************************************************/
+static inline int16_t picorv32_kyber_mont(int32_t a) {
+    int32_t r;
+    __asm__ (".insn r 0x2b, 1, 2, %0, %1, x0" : "=r"(r) : "r"(a));
+    return (int16_t)r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_barrett
+*
+* Description: Kyber Barrett reduction of two packed coefficients
+*              (ENABLE_KYBER_MONT)
+*
+* Arguments:   - uint32_t a: packed int16_t coefficients {hi, lo}
+*
+* Returns packed {barrett_reduce(hi), barrett_reduce(lo)}, each the centered
+* representative in {-(q-1)/2,...,(q-1)/2}
+**************************************************/
+static inline uint32_t picorv32_kyber_barrett(uint32_t a) {
+    uint32_t r;
+    __asm__ (".insn r 0x2b, 4, 2, %0, %1, x0" : "=r"(r) : "r"(a));
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_mac
+*
+* Description: Kyber Montgomery multiply-accumulate
+*              (ENABLE_KYBER_MONT and ENABLE_REGS_RS3)
+*
+* Arguments:   - int16_t a: first factor
+*              - int16_t b: second factor
+*              - int16_t c: addend
+*
+* Returns (int16_t)(c + fqmul(a, b))
+**************************************************/
+static inline int16_t picorv32_kyber_mac(int16_t a, int16_t b, int16_t c) {
+    int32_t r;
+    __asm__ (".insn r4 0x2b, 0, 1, %0, %1, %2, %3" : "=r"(r) : "r"(a), "r"(b), "r"(c));
+    return (int16_t)r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_cbd2
+*
+* Description: Kyber centered binomial sampling with eta = 2
+*              (ENABLE_KYBER_CBD)
+*
+* Arguments:   - uint32_t t: 32 bits of PRF output (little endian)
+*              - uint32_t k: index of the coefficient pair, 0..3
+*
+* Returns the packed coefficients {c[2k+1], c[2k]} sampled from byte k of t
+**************************************************/
+static inline uint32_t picorv32_kyber_cbd2(uint32_t t, uint32_t k) {
+    uint32_t r;
+    PICORV32_INSN_R(5, 2, r, t, k);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_cbd3
+*
+* Description: Kyber centered binomial sampling with eta = 3
+*              (ENABLE_KYBER_CBD)
+*
+* Arguments:   - uint32_t t: 24 bits of PRF output (little endian)
+*              - uint32_t k: index of the coefficient pair, 0..1
+*
+* Returns the packed coefficients {c[2k+1], c[2k]} sampled from bits
+* 12k+11..12k of t
+**************************************************/
+static inline uint32_t picorv32_kyber_cbd3(uint32_t t, uint32_t k) {
+    uint32_t r;
+    PICORV32_INSN_R(6, 2, r, t, k);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_rej
+*
+* Description: Kyber rejection sampling of two 12-bit candidates
+*              (ENABLE_REJ_UNIFORM)
+*
+* Arguments:   - uint32_t t: 3 bytes of XOF output (little endian)
+*
+* Returns the candidates of t that are smaller than q, in order, in bits
+* 11:0 and 27:16, and the number of accepted candidates in bits 31:30
+**************************************************/
+static inline uint32_t picorv32_kyber_rej(uint32_t t) {
+    uint32_t r;
+    __asm__ (".insn r 0x2b, 7, 2, %0, %1, x0" : "=r"(r) : "r"(t));
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_ct
+*
+* Description: Kyber Cooley-Tukey butterfly (ENABLE_KYBER_NTT)
+*
+* Arguments:   - uint32_t ab:  packed {b, a} = {r[j + len], r[j]}
+*              - int16_t zeta: twiddle factor (Montgomery domain)
+*
+* Returns packed {a - t, a + t} with t = fqmul(zeta, b)
+**************************************************/
+static inline uint32_t picorv32_kyber_ct(uint32_t ab, int16_t zeta) {
+    uint32_t r;
+    PICORV32_INSN_R(2, 2, r, ab, (int32_t)zeta);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_gs
+*
+* Description: Kyber Gentleman-Sande butterfly (ENABLE_KYBER_NTT)
+*
+* Arguments:   - uint32_t ab:  packed {b, a} = {r[j + len], r[j]}
+*              - int16_t zeta: twiddle factor (Montgomery domain)
+*
+* Returns packed {fqmul(zeta, b - a), barrett_reduce(a + b)}
+**************************************************/
+static inline uint32_t picorv32_kyber_gs(uint32_t ab, int16_t zeta) {
+    uint32_t r;
+    PICORV32_INSN_R(3, 2, r, ab, (int32_t)zeta);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_compress
+*
+* Description: Kyber compression of two coefficients
+*              (ENABLE_KYBER_COMPRESS)
+*
+* Arguments:   - uint32_t a: packed coefficients {a1, a0}, -q < ai < q
+*              - uint32_t d: number of bits, 1..11
+*
+* Returns packed {c1, c0} with ci = round(ai * 2^d / q) mod 2^d
+**************************************************/
+static inline uint32_t picorv32_kyber_compress(uint32_t a, uint32_t d) {
+    uint32_t r;
+    PICORV32_INSN_R(0, 6, r, a, d);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kyber_decompress
+*
+* Description: Kyber decompression of two coefficients
+*              (ENABLE_KYBER_COMPRESS)
+*
+* Arguments:   - uint32_t c: packed d-bit values {c1, c0}
+*              - uint32_t d: number of bits, 1..11
+*
+* Returns packed {a1, a0} with ai = round(ci * q / 2^d)
+**************************************************/
+static inline uint32_t picorv32_kyber_decompress(uint32_t c, uint32_t d) {
+    uint32_t r;
+    PICORV32_INSN_R(1, 6, r, c, d);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_dilithium_mont
+*
+* Description: Dilithium multiplication followed by Montgomery reduction
+*              (ENABLE_DILITHIUM_MONT)
+*
+* Arguments:   - int32_t a: first factor
+*              - int32_t b: second factor
+*
+* Returns r = a*b*2^{-32} (mod Q) with -Q < r < Q, Q = 8380417
+**************************************************/
+static inline int32_t picorv32_dilithium_mont(int32_t a, int32_t b) {
+    int32_t r;
+    PICORV32_INSN_R(0, 3, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_dilithium_rej
+*
+* Description: Dilithium rejection sampling of one 23-bit candidate
+*              (ENABLE_REJ_UNIFORM)
+*
+* Arguments:   - uint32_t t: 3 bytes of XOF output (little endian)
+*
+* Returns the candidate t & 0x7FFFFF, with bit 31 set if it is smaller than Q
+**************************************************/
+static inline uint32_t picorv32_dilithium_rej(uint32_t t) {
+    uint32_t r;
+    __asm__ (".insn r 0x2b, 1, 3, %0, %1, x0" : "=r"(r) : "r"(t));
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_dilithium_decompose
+*
+* Description: Dilithium3 decompose (ENABLE_DILITHIUM_ROUND)
+*
+* Arguments:   - int32_t a: standard representative, 0 <= a < Q
+*
+* Returns a1 in bits 31:28 and a0 as a signed 28-bit value in bits 27:0,
+* a mod^+ Q = a1*ALPHA + a0 with ALPHA = 2*GAMMA2
+**************************************************/
+static inline uint32_t picorv32_dilithium_decompose(int32_t a) {
+    uint32_t r;
+    __asm__ (".insn r 0x2b, 2, 3, %0, %1, x0" : "=r"(r) : "r"(a));
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_dilithium_power2round
+*
+* Description: Dilithium power2round with D = 13 (ENABLE_DILITHIUM_ROUND)
+*
+* Arguments:   - int32_t a: standard representative, 0 <= a < Q
+*
+* Returns a1 in bits 31:22 and a0 as a signed 22-bit value in bits 21:0,
+* a mod^+ Q = a1*2^D + a0
+**************************************************/
+static inline uint32_t picorv32_dilithium_power2round(int32_t a) {
+    uint32_t r;
+    __asm__ (".insn r 0x2b, 3, 3, %0, %1, x0" : "=r"(r) : "r"(a));
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_dilithium_make_hint
+*
+* Description: Dilithium3 hint bit (ENABLE_DILITHIUM_ROUND)
+*
+* Arguments:   - int32_t a0: low bits of input element
+*              - int32_t a1: high bits of input element
+*
+* Returns 1 if the low bits overflow into the high bits
+**************************************************/
+static inline uint32_t picorv32_dilithium_make_hint(int32_t a0, int32_t a1) {
+    uint32_t r;
+    PICORV32_INSN_R(4, 3, r, a0, a1);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_dilithium_use_hint
+*
+* Description: Dilithium3 high bits corrected by hint (ENABLE_DILITHIUM_ROUND)
+*
+* Arguments:   - int32_t a:     standard representative, 0 <= a < Q
+*              - uint32_t hint: hint bit
+*
+* Returns corrected high bits of a
+**************************************************/
+static inline int32_t picorv32_dilithium_use_hint(int32_t a, uint32_t hint) {
+    int32_t r;
+    PICORV32_INSN_R(5, 3, r, a, hint);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_gfmul12
+*
+* Description: Multiplication in GF(2^12) modulo x^12 + x^3 + 1
+*              (ENABLE_GFMUL12)
+*
+* Arguments:   - uint32_t a: first factor, bits 11:0
+*              - uint32_t b: second factor, bits 11:0
+*
+* Returns a*b in GF(2^12)
+**************************************************/
+static inline uint32_t picorv32_gfmul12(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_R(0, 4, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_clmul
+*
+* Description: Carry-less multiplication, lower half of the product
+*              (Zbkc, ENABLE_CLMUL or ENABLE_FAST_CLMUL)
+*
+* Arguments:   - uint32_t a: first factor
+*              - uint32_t b: second factor
+*
+* Returns bits 31:0 of the carry-less product a*b
+**************************************************/
+static inline uint32_t picorv32_clmul(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(1, 5, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_clmulh
+*
+* Description: Carry-less multiplication, upper half of the product
+*              (Zbkc, ENABLE_CLMUL or ENABLE_FAST_CLMUL)
+*
+* Arguments:   - uint32_t a: first factor
+*              - uint32_t b: second factor
+*
+* Returns bits 63:32 of the carry-less product a*b
+**************************************************/
+static inline uint32_t picorv32_clmulh(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(3, 5, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_grev, picorv32_shfl, picorv32_unshfl
+*
+* Description: Generalized bit reverse and (un)shuffle (Zbp, ENABLE_ZBP)
+*
+* Arguments:   - uint32_t a: input word
+*              - uint32_t c: control value, bits 4:0 for grev and bits 3:0
+*                            for [un]shfl
+*
+* Returns a with the bit permutation selected by c applied
+**************************************************/
+static inline uint32_t picorv32_grev(uint32_t a, uint32_t c) {
+    uint32_t r;
+    PICORV32_INSN_OP(5, 0x34, r, a, c);
+    return r;
+}
+
+static inline uint32_t picorv32_shfl(uint32_t a, uint32_t c) {
+    uint32_t r;
+    PICORV32_INSN_OP(1, 0x04, r, a, c);
+    return r;
+}
+
+static inline uint32_t picorv32_unshfl(uint32_t a, uint32_t c) {
+    uint32_t r;
+    PICORV32_INSN_OP(5, 0x04, r, a, c);
+    return r;
+}
+
+/*************************************************
+* Name:        PICORV32_GREVI, PICORV32_SHFLI, PICORV32_UNSHFLI
+*
+* Description: Immediate forms of grev, shfl and unshfl (Zbp, ENABLE_ZBP)
+*
+* Arguments:   - rd:  output word
+*              - rs1: input word
+*              - imm: control value, must be a constant
+*
+* grevi 7, grevi 24, shfli 15 and unshfli 15 are the Zbkb brev8, rev8, zip
+* and unzip instructions.
+**************************************************/
+#define PICORV32_GREVI(rd, rs1, imm) \
+    __asm__ (".insn i 0x13, 5, %0, %1, %2" : "=r"(rd) : "r"(rs1), "i"(0x680 | (imm)))
+#define PICORV32_SHFLI(rd, rs1, imm) \
+    __asm__ (".insn i 0x13, 1, %0, %1, %2" : "=r"(rd) : "r"(rs1), "i"(0x080 | (imm)))
+#define PICORV32_UNSHFLI(rd, rs1, imm) \
+    __asm__ (".insn i 0x13, 5, %0, %1, %2" : "=r"(rd) : "r"(rs1), "i"(0x080 | (imm)))
+
+/*************************************************
+* Name:        picorv32_zip
+*
+* Description: Interleave the lower and upper halfword of a word
+*              (Zbkb/Zbp shfli 15, ENABLE_ZBKB or ENABLE_ZBP)
+*
+* Arguments:   - uint32_t a: input word
+*
+* Returns a word with bit i of a in bit 2i and bit 16+i of a in bit 2i+1
+**************************************************/
+static inline uint32_t picorv32_zip(uint32_t a) {
+    uint32_t r;
+    PICORV32_SHFLI(r, a, 15);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_pack, picorv32_packu
+*
+* Description: Pack the lower (pack, Zbkb/Zbp) or upper (packu, Zbp)
+*              halfwords of two words (ENABLE_ZBKB or ENABLE_ZBP / ENABLE_ZBP)
+*
+* Arguments:   - uint32_t lo: source of the lower result halfword
+*              - uint32_t hi: source of the upper result halfword
+*
+* Returns {hi[15:0], lo[15:0]} (pack) or {hi[31:16], lo[31:16]} (packu)
+**************************************************/
+static inline uint32_t picorv32_pack(uint32_t lo, uint32_t hi) {
+    uint32_t r;
+    PICORV32_INSN_OP(4, 0x04, r, lo, hi);
+    return r;
+}
+
+static inline uint32_t picorv32_packu(uint32_t lo, uint32_t hi) {
+    uint32_t r;
+    PICORV32_INSN_OP(4, 0x24, r, lo, hi);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_add16, picorv32_sub16
+*
+* Description: Packed 2x16-bit addition and subtraction, wrapping
+*              (ENABLE_SIMD16)
+*
+* Arguments:   - uint32_t a: packed first operands
+*              - uint32_t b: packed second operands
+*
+* Returns packed {a.hi +/- b.hi, a.lo +/- b.lo} (mod 2^16)
+**************************************************/
+static inline uint32_t picorv32_add16(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_P(0, 0x20, r, a, b);
+    return r;
+}
+
+static inline uint32_t picorv32_sub16(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_P(0, 0x21, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_kadd16, picorv32_ksub16
+*
+* Description: Packed 2x16-bit signed addition and subtraction, saturating
+*              (ENABLE_SIMD16)
+*
+* Arguments:   - uint32_t a: packed first operands
+*              - uint32_t b: packed second operands
+*
+* Returns packed {a.hi +/- b.hi, a.lo +/- b.lo}, clamped to the int16_t range
+**************************************************/
+static inline uint32_t picorv32_kadd16(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_P(0, 0x08, r, a, b);
+    return r;
+}
+
+static inline uint32_t picorv32_ksub16(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_P(0, 0x09, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_smbb16, picorv32_smtt16
+*
+* Description: Signed 16x16-bit multiplication of the bottom (bits 15:0) or
+*              top (bits 31:16) halfwords (ENABLE_SIMD16)
+*
+* Arguments:   - uint32_t a: packed first factors
+*              - uint32_t b: packed second factors
+*
+* Returns the 32-bit product a.lo * b.lo or a.hi * b.hi
+**************************************************/
+static inline int32_t picorv32_smbb16(uint32_t a, uint32_t b) {
+    int32_t r;
+    PICORV32_INSN_P(1, 0x04, r, a, b);
+    return r;
+}
+
+static inline int32_t picorv32_smtt16(uint32_t a, uint32_t b) {
+    int32_t r;
+    PICORV32_INSN_P(1, 0x14, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_pkbb16, picorv32_pktt16
+*
+* Description: Pack the bottom or top halfwords of two registers
+*              (ENABLE_SIMD16)
+*
+* Arguments:   - uint32_t hi: source of the upper result halfword
+*              - uint32_t lo: source of the lower result halfword
+*
+* Returns {hi.lo, lo.lo} (pkbb16) or {hi.hi, lo.hi} (pktt16)
+**************************************************/
+static inline uint32_t picorv32_pkbb16(uint32_t hi, uint32_t lo) {
+    uint32_t r;
+    PICORV32_INSN_P(1, 0x07, r, hi, lo);
+    return r;
+}
+
+static inline uint32_t picorv32_pktt16(uint32_t hi, uint32_t lo) {
+    uint32_t r;
+    PICORV32_INSN_P(1, 0x17, r, hi, lo);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_sha256sig0, picorv32_sha256sig1,
+*              picorv32_sha256sum0, picorv32_sha256sum1
+*
+* Description: SHA-256 sigma0/sigma1 and Sigma0/Sigma1 functions
+*              (Zknh, ENABLE_ZKNH)
+*
+* Arguments:   - uint32_t x: input word
+**************************************************/
+static inline uint32_t picorv32_sha256sig0(uint32_t x) {
+    uint32_t r;
+    __asm__ (".insn i 0x13, 1, %0, %1, 0x102" : "=r"(r) : "r"(x));
+    return r;
+}
+
+static inline uint32_t picorv32_sha256sig1(uint32_t x) {
+    uint32_t r;
+    __asm__ (".insn i 0x13, 1, %0, %1, 0x103" : "=r"(r) : "r"(x));
+    return r;
+}
+
+static inline uint32_t picorv32_sha256sum0(uint32_t x) {
+    uint32_t r;
+    __asm__ (".insn i 0x13, 1, %0, %1, 0x100" : "=r"(r) : "r"(x));
+    return r;
+}
+
+static inline uint32_t picorv32_sha256sum1(uint32_t x) {
+    uint32_t r;
+    __asm__ (".insn i 0x13, 1, %0, %1, 0x101" : "=r"(r) : "r"(x));
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_sha512sum0r, picorv32_sha512sum1r
+*
+* Description: One half of the SHA-512 Sigma0/Sigma1 functions
+*              (Zknh, ENABLE_ZKNH)
+*
+* Arguments:   - uint32_t a: low (high) half of the input
+*              - uint32_t b: high (low) half of the input
+*
+* Returns the low (high) half of the result
+**************************************************/
+static inline uint32_t picorv32_sha512sum0r(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(0, 0x28, r, a, b);
+    return r;
+}
+
+static inline uint32_t picorv32_sha512sum1r(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(0, 0x29, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        picorv32_sha512sig0l, picorv32_sha512sig0h,
+*              picorv32_sha512sig1l, picorv32_sha512sig1h
+*
+* Description: Low (l) and high (h) half of the SHA-512 sigma0/sigma1
+*              functions (Zknh, ENABLE_ZKNH)
+*
+* Arguments:   - uint32_t a: low half (l) or high half (h) of the input
+*              - uint32_t b: the other half of the input
+**************************************************/
+static inline uint32_t picorv32_sha512sig0l(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(0, 0x2a, r, a, b);
+    return r;
+}
+
+static inline uint32_t picorv32_sha512sig0h(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(0, 0x2e, r, a, b);
+    return r;
+}
+
+static inline uint32_t picorv32_sha512sig1l(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(0, 0x2b, r, a, b);
+    return r;
+}
+
+static inline uint32_t picorv32_sha512sig1h(uint32_t a, uint32_t b) {
+    uint32_t r;
+    PICORV32_INSN_OP(0, 0x2f, r, a, b);
+    return r;
+}
+
+/*************************************************
+* Name:        PICORV32_AES32ESMI, PICORV32_AES32ESI,
+*              PICORV32_AES32DSMI, PICORV32_AES32DSI
+*
+* Description: AES round instructions (ENABLE_AES32)
+*
+*              Byte bs of rs2 is substituted with the forward (ES) or
+*              inverse (DS) S-box, multiplied with the (Inv)MixColumns
+*              column for the *MI variants, rotated left by 8*bs bits and
+*              XORed into rs1.
+*
+* Arguments:   - rd:  output word
+*              - rs1: round key or partial result word
+*              - rs2: state word
+*              - bs:  byte select, must be a constant 0..3
+*
+* These are macros, since bs is encoded in the instruction (funct7[6:5]).
+**************************************************/
+#define PICORV32_AES32(f7, bs, rd, rs1, rs2) \
+    __asm__ (".insn r 0x33, 0, %3, %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2), "i"((f7) | ((bs) << 5)))
+
+#define PICORV32_AES32ESI(rd, rs1, rs2, bs)  PICORV32_AES32(0x11, bs, rd, rs1, rs2)
+#define PICORV32_AES32ESMI(rd, rs1, rs2, bs) PICORV32_AES32(0x13, bs, rd, rs1, rs2)
+#define PICORV32_AES32DSI(rd, rs1, rs2, bs)  PICORV32_AES32(0x15, bs, rd, rs1, rs2)
+#define PICORV32_AES32DSMI(rd, rs1, rs2, bs) PICORV32_AES32(0x17, bs, rd, rs1, rs2)
+
+#endif
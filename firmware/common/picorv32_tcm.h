@@ -0,0 +1,25 @@
+#ifndef PICORV32_TCM_H
+#define PICORV32_TCM_H
+
+/* Placement of data in the tightly-coupled data memory of the core (TCM_WORDS
+ * and TCM_ADDR in picorv32.v). Loads and stores to the TCM complete without
+ * going through the memory interface, so it pays off for the zetas tables and
+ * the polynomials that the NTT and basemul loops work on.
+ *
+ * Variables marked with PICORV32_TCM / PICORV32_TCM_CONST go to the .tcm
+ * section of firmware/riscv.ld and firmware/sections.lds, which is copied to
+ * the TCM at startup. Local buffers have to be made static for this, so the
+ * functions using them are not reentrant. Build with -DENABLE_TCM for a core
+ * with TCM; without it the variables stay in normal memory.
+ */
+
+//#define ENABLE_TCM
+#ifdef ENABLE_TCM
+#define PICORV32_TCM            __attribute__((section(".tcm.data")))
+#define PICORV32_TCM_CONST      __attribute__((section(".tcm.rodata")))
+#else
+#define PICORV32_TCM
+#define PICORV32_TCM_CONST
+#endif // ENABLE_TCM
+
+#endif
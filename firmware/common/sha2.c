@@ -9,6 +9,11 @@
 
 #include "sha2.h"
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 static uint32_t load_bigendian_32(const uint8_t *x) {
     return (uint32_t)(x[3]) | (((uint32_t)(x[2])) << 8) |
            (((uint32_t)(x[1])) << 16) | (((uint32_t)(x[0])) << 24);
@@ -56,6 +61,7 @@ static void store_bigendian_64(uint8_t *x, uint64_t u) {
 #define Ch(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
 #define Maj(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
 #define Sigma0_32(x) (ROTR_32(x, 2) ^ ROTR_32(x,13) ^ ROTR_32(x,22))
 #define Sigma1_32(x) (ROTR_32(x, 6) ^ ROTR_32(x,11) ^ ROTR_32(x,25))
 #define sigma0_32(x) (ROTR_32(x, 7) ^ ROTR_32(x,18) ^ SHR(x, 3))
@@ -65,6 +71,21 @@ static void store_bigendian_64(uint8_t *x, uint64_t u) {
 #define Sigma1_64(x) (ROTR_64(x, 14) ^ ROTR_64(x, 18) ^ ROTR_64(x, 41))
 #define sigma0_64(x) (ROTR_64(x, 1) ^ ROTR_64(x, 8) ^ SHR(x, 7))
 #define sigma1_64(x) (ROTR_64(x, 19) ^ ROTR_64(x, 61) ^ SHR(x, 6))
+#else
+#define Sigma0_32(x) picorv32_sha256sum0(x)
+#define Sigma1_32(x) picorv32_sha256sum1(x)
+#define sigma0_32(x) picorv32_sha256sig0(x)
+#define sigma1_32(x) picorv32_sha256sig1(x)
+
+/* The 64-bit operands live in register pairs; each instruction computes one
+ * half of the result from both halves of the input. */
+#define LO(x) ((uint32_t)(x))
+#define HI(x) ((uint32_t)((x) >> 32))
+#define Sigma0_64(x) ((uint64_t)picorv32_sha512sum0r(HI(x), LO(x)) << 32 | picorv32_sha512sum0r(LO(x), HI(x)))
+#define Sigma1_64(x) ((uint64_t)picorv32_sha512sum1r(HI(x), LO(x)) << 32 | picorv32_sha512sum1r(LO(x), HI(x)))
+#define sigma0_64(x) ((uint64_t)picorv32_sha512sig0h(HI(x), LO(x)) << 32 | picorv32_sha512sig0l(LO(x), HI(x)))
+#define sigma1_64(x) ((uint64_t)picorv32_sha512sig1h(HI(x), LO(x)) << 32 | picorv32_sha512sig1l(LO(x), HI(x)))
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
 #define M_32(w0, w14, w9, w1) w0 = sigma1_32(w14) + (w9) + sigma0_32(w1) + (w0);
 #define M_64(w0, w14, w9, w1) w0 = sigma1_64(w14) + (w9) + sigma0_64(w1) + (w0);
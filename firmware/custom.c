@@ -0,0 +1,48 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+#include "firmware.h"
+#include "common/picorv32_insn.h"
+
+// Test for the accelerator slots of picorv32_pcpi_custom in testbench.v
+// (make test_custom). Both slots return (rs1 ^ rs2) + rs3.
+
+static void custom_check(const char *name, uint32_t result, uint32_t expected)
+{
+	print_str(name);
+	print_hex(result, 8);
+	print_str("  ");
+	print_hex(expected, 8);
+
+	if (result != expected) {
+		print_str("  ERROR!\n");
+		__asm__ volatile ("ebreak");
+		return;
+	}
+
+	print_str("  OK\n");
+}
+
+void custom_test(void)
+{
+	uint32_t a = 0x12345678, b = 0x0f0f0f0f, c = 0x01010101;
+	uint32_t r, s0;
+
+	// custom-1 with funct7 = 0000000 and 0100000 (rs3 = x0 and x8): must
+	// not be executed as add/sub by the core
+	__asm__ volatile ("mv %0, s0" : "=r"(s0));
+	PICORV32_INSN_CUSTOM1(0, 0x00, r, a, b);
+	custom_check("custom1 f7=00    ", r, a ^ b);
+	PICORV32_INSN_CUSTOM1(0, 0x20, r, a, b);
+	custom_check("custom1 f7=20    ", r, (a ^ b) + s0);
+
+	// R4 forms with a third source register and a multi-cycle slot
+	PICORV32_INSN_CUSTOM0_R4(0, 3, r, a, b, c);
+	custom_check("custom0 r4 f2=3  ", r, (a ^ b) + c);
+	PICORV32_INSN_CUSTOM1_R4(0, 1, r, a, b, c);
+	custom_check("custom1 r4 f2=1  ", r, (a ^ b) + c);
+}
@@ -1,9 +1,23 @@
 #include "ntt.h"
 #include "params.h"
+#include "picorv32_tcm.h"
 #include "reduce.h"
 #include <stdint.h>
 
-static const int32_t zetas[N] = {
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+//#define DISABLE_HWLOOP
+#if defined(DISABLE_CUSTOM_INSTRUCTION) && !defined(DISABLE_HWLOOP)
+#define DISABLE_HWLOOP // the loop bodies use dilithium_mont
+#endif
+
+//#define ENABLE_NTT_ENGINE
+#include "ntt_engine.h"
+
+static PICORV32_TCM_CONST const int32_t zetas[N] = {
     0,    25847, -2608894,  -518909,   237124,  -777960,  -876248,   466468,
     1826347,  2353451,  -359251, -2091905,  3119733, -2884855,  3111497,  2680103,
     2725464,  1024112, -1079900,  3585928,  -549488, -1119584,  2619752, -2108549,
@@ -38,6 +52,72 @@ static const int32_t zetas[N] = {
     -554416,  3919660,   -48306, -1362209,  3937738,  1400424,  -846154,  1976782
 };
 
+#if !defined(ENABLE_NTT_ENGINE) && !defined(DISABLE_HWLOOP)
+/*************************************************
+* Name:        ct_hwloop
+*
+* Description: One block of Cooley-Tukey butterflies of the NTT,
+*              (a[j], a[j + len]) for j = 0..len-1, as a hardware loop
+*              (ENABLE_HWLOOP) around dilithium_mont
+*
+* Arguments:   - int32_t *a: pointer to the first coefficient of the block
+*              - unsigned int len: distance of the butterfly inputs
+*              - int32_t zeta: twiddle factor (Montgomery domain)
+**************************************************/
+static void ct_hwloop(int32_t *a, unsigned int len, int32_t zeta) {
+    int32_t *b = a + len;
+    int32_t x, y, t;
+
+    __asm__ volatile (
+        PICORV32_HWLOOP_BEGIN("%[len]", 9)
+        "lw   %[t], 0(%[b])\n\t"
+        ".insn r 0x2b, 0, 3, %[t], %[zeta], %[t]\n\t" // dilithium_mont
+        "lw   %[x], 0(%[a])\n\t"
+        "sub  %[y], %[x], %[t]\n\t"
+        "add  %[x], %[x], %[t]\n\t"
+        "sw   %[y], 0(%[b])\n\t"
+        "sw   %[x], 0(%[a])\n\t"
+        "addi %[a], %[a], 4\n\t"
+        "addi %[b], %[b], 4\n\t"
+        PICORV32_HWLOOP_END
+        : [a] "+r"(a), [b] "+r"(b), [x] "=&r"(x), [y] "=&r"(y), [t] "=&r"(t)
+        : [len] "r"(len), [zeta] "r"(zeta)
+        : "memory");
+}
+
+/*************************************************
+* Name:        gs_hwloop
+*
+* Description: One block of Gentleman-Sande butterflies of the inverse NTT,
+*              (a[j], a[j + len]) for j = 0..len-1, as a hardware loop
+*              (ENABLE_HWLOOP) around dilithium_mont
+*
+* Arguments:   - int32_t *a: pointer to the first coefficient of the block
+*              - unsigned int len: distance of the butterfly inputs
+*              - int32_t zeta: twiddle factor (Montgomery domain)
+**************************************************/
+static void gs_hwloop(int32_t *a, unsigned int len, int32_t zeta) {
+    int32_t *b = a + len;
+    int32_t x, y, t;
+
+    __asm__ volatile (
+        PICORV32_HWLOOP_BEGIN("%[len]", 9)
+        "lw   %[x], 0(%[a])\n\t"
+        "lw   %[y], 0(%[b])\n\t"
+        "add  %[t], %[x], %[y]\n\t"
+        "sub  %[y], %[x], %[y]\n\t"
+        ".insn r 0x2b, 0, 3, %[y], %[zeta], %[y]\n\t" // dilithium_mont
+        "sw   %[t], 0(%[a])\n\t"
+        "sw   %[y], 0(%[b])\n\t"
+        "addi %[a], %[a], 4\n\t"
+        "addi %[b], %[b], 4\n\t"
+        PICORV32_HWLOOP_END
+        : [a] "+r"(a), [b] "+r"(b), [x] "=&r"(x), [y] "=&r"(y), [t] "=&r"(t)
+        : [len] "r"(len), [zeta] "r"(zeta)
+        : "memory");
+}
+#endif // DISABLE_HWLOOP
+
 /*************************************************
 * Name:        PQCLEAN_DILITHIUM3_CLEAN_ntt
 *
@@ -47,20 +127,35 @@ static const int32_t zetas[N] = {
 * Arguments:   - uint32_t p[N]: input/output coefficient array
 **************************************************/
 void PQCLEAN_DILITHIUM3_CLEAN_ntt(int32_t a[N]) {
+#ifndef ENABLE_NTT_ENGINE
     unsigned int len, start, j, k;
-    int32_t zeta, t;
+    int32_t zeta;
+#ifdef DISABLE_HWLOOP
+    int32_t t;
+#endif // DISABLE_HWLOOP
 
     k = 0;
     for (len = 128; len > 0; len >>= 1) {
         for (start = 0; start < N; start = j + len) {
             zeta = zetas[++k];
+#ifndef DISABLE_HWLOOP
+            ct_hwloop(&a[start], len, zeta);
+            j = start + len;
+#else
             for (j = start; j < start + len; ++j) {
-                t = PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce((int64_t)zeta * a[j + len]);
+                t = PQCLEAN_DILITHIUM3_CLEAN_montgomery_multiply(zeta, a[j + len]);
                 a[j + len] = a[j] - t;
                 a[j] = a[j] + t;
             }
+#endif // DISABLE_HWLOOP
         }
     }
+#else
+    PQCLEAN_DILITHIUM3_CLEAN_ntt_engine_init();
+    ntt_engine_load32(0, a, N);
+    ntt_engine_start(NTT_ENGINE_OP_NTT, 0);
+    ntt_engine_store32(a, 0, N);
+#endif // ENABLE_NTT_ENGINE
 }
 
 /*************************************************
@@ -75,24 +170,54 @@ void PQCLEAN_DILITHIUM3_CLEAN_ntt(int32_t a[N]) {
 * Arguments:   - uint32_t p[N]: input/output coefficient array
 **************************************************/
 void PQCLEAN_DILITHIUM3_CLEAN_invntt_tomont(int32_t a[N]) {
+#ifndef ENABLE_NTT_ENGINE
     unsigned int start, len, j, k;
-    int32_t t, zeta;
+    int32_t zeta;
+#ifdef DISABLE_HWLOOP
+    int32_t t;
+#endif // DISABLE_HWLOOP
     const int32_t f = 41978; // mont^2/256
 
     k = 256;
     for (len = 1; len < N; len <<= 1) {
         for (start = 0; start < N; start = j + len) {
             zeta = -zetas[--k];
+#ifndef DISABLE_HWLOOP
+            gs_hwloop(&a[start], len, zeta);
+            j = start + len;
+#else
             for (j = start; j < start + len; ++j) {
                 t = a[j];
                 a[j] = t + a[j + len];
                 a[j + len] = t - a[j + len];
-                a[j + len] = PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce((int64_t)zeta * a[j + len]);
+                a[j + len] = PQCLEAN_DILITHIUM3_CLEAN_montgomery_multiply(zeta, a[j + len]);
             }
+#endif // DISABLE_HWLOOP
         }
     }
 
     for (j = 0; j < N; ++j) {
-        a[j] = PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce((int64_t)f * a[j]);
+        a[j] = PQCLEAN_DILITHIUM3_CLEAN_montgomery_multiply(f, a[j]);
+    }
+#else
+    PQCLEAN_DILITHIUM3_CLEAN_ntt_engine_init();
+    ntt_engine_load32(0, a, N);
+    ntt_engine_start(NTT_ENGINE_OP_INVNTT, 0);
+    ntt_engine_store32(a, 0, N);
+#endif // ENABLE_NTT_ENGINE
+}
+
+/*************************************************
+* Name:        PQCLEAN_DILITHIUM3_CLEAN_ntt_engine_init
+*
+* Description: Loads the zetas into the NTT engine (picosoc/ntt_engine.v)
+*              on first use
+**************************************************/
+void PQCLEAN_DILITHIUM3_CLEAN_ntt_engine_init(void) {
+    static int loaded = 0;
+
+    if (!loaded) {
+        ntt_engine_setup32(zetas, N);
+        loaded = 1;
     }
 }
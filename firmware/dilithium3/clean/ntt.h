@@ -7,4 +7,6 @@ void PQCLEAN_DILITHIUM3_CLEAN_ntt(int32_t a[N]);
 
 void PQCLEAN_DILITHIUM3_CLEAN_invntt_tomont(int32_t a[N]);
 
+void PQCLEAN_DILITHIUM3_CLEAN_ntt_engine_init(void);
+
 #endif
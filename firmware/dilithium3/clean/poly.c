@@ -6,6 +6,11 @@
 #include "symmetric.h"
 #include <stdint.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 #define DBENCH_START()
 #define DBENCH_STOP(t)
 
@@ -157,7 +162,7 @@ void PQCLEAN_DILITHIUM3_CLEAN_poly_pointwise_montgomery(poly *c, const poly *a,
     DBENCH_START();
 
     for (i = 0; i < N; ++i) {
-        c->coeffs[i] = PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce((int64_t)a->coeffs[i] * b->coeffs[i]);
+        c->coeffs[i] = PQCLEAN_DILITHIUM3_CLEAN_montgomery_multiply(a->coeffs[i], b->coeffs[i]);
     }
 
     DBENCH_STOP(*tmul);
@@ -179,9 +184,18 @@ void PQCLEAN_DILITHIUM3_CLEAN_poly_power2round(poly *a1, poly *a0, const poly *a
     unsigned int i;
     DBENCH_START();
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < N; ++i) {
         a1->coeffs[i] = PQCLEAN_DILITHIUM3_CLEAN_power2round(&a0->coeffs[i], a->coeffs[i]);
     }
+#else
+    uint32_t t;
+    for (i = 0; i < N; ++i) {
+        t = picorv32_dilithium_power2round(a->coeffs[i]);
+        a1->coeffs[i] = (int32_t)(t >> 22);
+        a0->coeffs[i] = (int32_t)(t << 10) >> 10;
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
     DBENCH_STOP(*tround);
 }
@@ -203,9 +217,18 @@ void PQCLEAN_DILITHIUM3_CLEAN_poly_decompose(poly *a1, poly *a0, const poly *a)
     unsigned int i;
     DBENCH_START();
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < N; ++i) {
         a1->coeffs[i] = PQCLEAN_DILITHIUM3_CLEAN_decompose(&a0->coeffs[i], a->coeffs[i]);
     }
+#else
+    uint32_t t;
+    for (i = 0; i < N; ++i) {
+        t = picorv32_dilithium_decompose(a->coeffs[i]);
+        a1->coeffs[i] = (int32_t)(t >> 28);
+        a0->coeffs[i] = (int32_t)(t << 4) >> 4;
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
     DBENCH_STOP(*tround);
 }
@@ -228,7 +251,11 @@ unsigned int PQCLEAN_DILITHIUM3_CLEAN_poly_make_hint(poly *h, const poly *a0, co
     DBENCH_START();
 
     for (i = 0; i < N; ++i) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         h->coeffs[i] = PQCLEAN_DILITHIUM3_CLEAN_make_hint(a0->coeffs[i], a1->coeffs[i]);
+#else
+        h->coeffs[i] = picorv32_dilithium_make_hint(a0->coeffs[i], a1->coeffs[i]);
+#endif // DISABLE_CUSTOM_INSTRUCTION
         s += h->coeffs[i];
     }
 
@@ -250,7 +277,11 @@ void PQCLEAN_DILITHIUM3_CLEAN_poly_use_hint(poly *b, const poly *a, const poly *
     DBENCH_START();
 
     for (i = 0; i < N; ++i) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         b->coeffs[i] = PQCLEAN_DILITHIUM3_CLEAN_use_hint(a->coeffs[i], h->coeffs[i]);
+#else
+        b->coeffs[i] = picorv32_dilithium_use_hint(a->coeffs[i], h->coeffs[i]);
+#endif // DISABLE_CUSTOM_INSTRUCTION
     }
 
     DBENCH_STOP(*tround);
@@ -321,11 +352,18 @@ static unsigned int rej_uniform(int32_t *a,
         t  = buf[pos++];
         t |= (uint32_t)buf[pos++] << 8;
         t |= (uint32_t)buf[pos++] << 16;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         t &= 0x7FFFFF;
 
         if (t < Q) {
             a[ctr++] = t;
         }
+#else
+        /* a[ctr] is written unconditionally, ctr < len */
+        t = picorv32_dilithium_rej(t);
+        a[ctr] = t & 0x7FFFFF;
+        ctr += t >> 31;
+#endif // DISABLE_CUSTOM_INSTRUCTION
     }
 
     DBENCH_STOP(*tsample);
@@ -3,6 +3,12 @@
 #include "polyvec.h"
 #include <stdint.h>
 
+//#define ENABLE_NTT_ENGINE
+#ifdef ENABLE_NTT_ENGINE
+#include "ntt.h"
+#include "ntt_engine.h"
+#endif // ENABLE_NTT_ENGINE
+
 /*************************************************
 * Name:        expand_mat
 *
@@ -124,6 +130,7 @@ void PQCLEAN_DILITHIUM3_CLEAN_polyvecl_pointwise_acc_montgomery(poly *w,
         const polyvecl *u,
         const polyvecl *v) {
     unsigned int i;
+#ifndef ENABLE_NTT_ENGINE
     poly t;
 
     PQCLEAN_DILITHIUM3_CLEAN_poly_pointwise_montgomery(w, &u->vec[0], &v->vec[0]);
@@ -131,6 +138,15 @@ void PQCLEAN_DILITHIUM3_CLEAN_polyvecl_pointwise_acc_montgomery(poly *w,
         PQCLEAN_DILITHIUM3_CLEAN_poly_pointwise_montgomery(&t, &u->vec[i], &v->vec[i]);
         PQCLEAN_DILITHIUM3_CLEAN_poly_add(w, w, &t);
     }
+#else
+    PQCLEAN_DILITHIUM3_CLEAN_ntt_engine_init();
+    for (i = 0; i < L; ++i) {
+        ntt_engine_load32(0, u->vec[i].coeffs, N);
+        ntt_engine_load32(1, v->vec[i].coeffs, N);
+        ntt_engine_start(i == 0 ? NTT_ENGINE_OP_MUL : NTT_ENGINE_OP_MAC, 0);
+    }
+    ntt_engine_store32(w->coeffs, 2, N);
+#endif // ENABLE_NTT_ENGINE
 }
 
 /*************************************************
@@ -2,6 +2,11 @@
 #include "reduce.h"
 #include <stdint.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 /*************************************************
 * Name:        PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce
 *
@@ -20,6 +25,25 @@ int32_t PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce(int64_t a) {
     return t;
 }
 
+/*************************************************
+* Name:        PQCLEAN_DILITHIUM3_CLEAN_montgomery_multiply
+*
+* Description: Multiplication followed by Montgomery reduction,
+*              montgomery_reduce((int64_t)a * b).
+*
+* Arguments:   - int32_t a: first factor
+*              - int32_t b: second factor
+*
+* Returns r \equiv a*b*2^{-32} (mod Q) such that -Q < r < Q.
+**************************************************/
+int32_t PQCLEAN_DILITHIUM3_CLEAN_montgomery_multiply(int32_t a, int32_t b) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
+    return PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce((int64_t)a * b);
+#else
+    return picorv32_dilithium_mont(a, b);
+#endif // DISABLE_CUSTOM_INSTRUCTION
+}
+
 /*************************************************
 * Name:        PQCLEAN_DILITHIUM3_CLEAN_reduce32
 *
@@ -8,6 +8,8 @@
 
 int32_t PQCLEAN_DILITHIUM3_CLEAN_montgomery_reduce(int64_t a);
 
+int32_t PQCLEAN_DILITHIUM3_CLEAN_montgomery_multiply(int32_t a, int32_t b);
+
 int32_t PQCLEAN_DILITHIUM3_CLEAN_reduce32(int32_t a);
 
 int32_t PQCLEAN_DILITHIUM3_CLEAN_caddq(int32_t a);
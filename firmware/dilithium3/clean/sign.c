@@ -1,6 +1,7 @@
 #include "fips202.h"
 #include "packing.h"
 #include "params.h"
+#include "picorv32_tcm.h"
 #include "poly.h"
 #include "polyvec.h"
 #include "randombytes.h"
@@ -94,7 +95,8 @@ int PQCLEAN_DILITHIUM3_CLEAN_crypto_sign_signature(uint8_t *sig,
     uint8_t seedbuf[2 * SEEDBYTES + TRBYTES + RNDBYTES + 2 * CRHBYTES];
     uint8_t *rho, *tr, *key, *mu, *rhoprime, *rnd;
     uint16_t nonce = 0;
-    polyvecl mat[K], s1, y, z;
+    static PICORV32_TCM polyvecl y, z;
+    polyvecl mat[K], s1;
     polyveck t0, s2, w1, w0, h;
     poly cp;
     shake256incctx state;
@@ -40,4 +40,7 @@ void multest(void);
 // stats.c
 void stats(void);
 
+// custom.c
+void custom_test(void);
+
 #endif
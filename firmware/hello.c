@@ -8,6 +8,9 @@
 #include "firmware.h"
 
 //#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "common/picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
 #define DISABLE_BENCH_MARKING_MIXCOLUMN
 #define DISABLE_BENCH_MARKING_ENCRYPT
 #define DISABLE_BENCH_MARKING_DECRYPT
@@ -95,6 +98,7 @@ typedef u_int8 state_t[4][4];
 
 
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
 // The lookup-tables are marked const so they can be placed in read-only storage instead of RAM
 // The numbers below can be computed dynamically trading ROM for RAM - 
 // This can be useful in (embedded) bootloader applications, where ROM is often limited.
@@ -135,6 +139,7 @@ static const u_int8 rsbox[256] = {
   0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
   0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
   0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d };
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
 
 // The round constant word array, Rcon[i], contains the values given by 
@@ -156,6 +161,7 @@ static const u_int8 Rcon[11] = {
 /*****************************************************************************/
 /* Private functions:                                                        */
 /*****************************************************************************/
+#ifdef DISABLE_CUSTOM_INSTRUCTION
 /*
 static u_int8 getSBoxValue(u_int8 num)
 {
@@ -163,18 +169,27 @@ static u_int8 getSBoxValue(u_int8 num)
 }
 */
 #define getSBoxValue(num) (sbox[(num)])
+#else
+// The S-box is part of the aes32esi instruction, there is no table in memory.
+static u_int8 getSBoxValue(u_int8 num)
+{
+  uint32_t result, x = num;
 
-static void call_custom_instruction_aes128(void)
+  PICORV32_AES32ESI(result, 0, x, 0);
+  return (u_int8)result;
+}
+
+static void call_custom_instruction_aes32(void)
 {
   uint32_t result, num1=0x22, num2=0x28;
 #ifndef DISABLE_BENCH_MARKING
     int End_Time, Begin_Time;
     time (Begin_Time);
 #endif // DISABLE_BENCH_MARKING
-  __asm__ volatile ("aes128 %0, %1,%2\n" :"=r"(result):"r"(num1),"r"(num2):);
+  PICORV32_AES32ESMI(result, num1, num2, 0);
 #ifndef DISABLE_BENCH_MARKING
     time (End_Time);
-    print_str("aes128 total cycles:");
+    print_str("aes32esmi total cycles:");
     print_dec(End_Time - Begin_Time);
     print_str(", Begin cycles:");
     print_dec(Begin_Time);
@@ -182,12 +197,13 @@ static void call_custom_instruction_aes128(void)
     print_dec(End_Time);
     print_str("\n");
 #endif // DISABLE_BENCH_MARKING
-  print_str("call_custom_instruction_aes128:");
+  print_str("call_custom_instruction_aes32:");
   print_dec(result);
   print_str(", 0x");
-  print_hex(result,2);
+  print_hex(result,8);
   print_str("\n");
 }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
 // This function produces Nb(Nr+1) round keys. The round keys are used in each round to decrypt the states. 
 static void KeyExpansion(u_int8* RoundKey, const u_int8* Key)
@@ -279,6 +295,7 @@ static void AES_ctx_set_iv(struct AES_ctx* ctx, const u_int8* iv)
 }
 #endif*/
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
 // This function adds the round key to state.
 // The round key is added to the state by an XOR function.
 static void AddRoundKey(u_int8 round, state_t* state, const u_int8* RoundKey)
@@ -340,14 +357,7 @@ static void ShiftRows(state_t* state)
 
 static u_int8 xtime(u_int8 x)
 {
-#ifndef DISABLE_CUSTOM_INSTRUCTION
-  uint32_t result, num1=(uint32_t)x, num2=0;
-
-  __asm__ volatile ("aes128 %0, %1,%2\n" :"=r"(result):"r"(num1),"r"(num2):);
-  return (u_int8)result;
-#else
   return ((x<<1) ^ (((x>>7) & 1) * 0x1b));
-#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 // MixColumns function mixes the columns of the state matrix
@@ -712,6 +722,160 @@ static void InvCipher(state_t* state, const u_int8* RoundKey)
   }
 
 }
+#else
+// With the aes32 instructions a full round is computed per state column:
+// aes32esmi/aes32dsmi perform SubBytes and MixColumns on one byte and XOR
+// the result into the accumulated column, the byte selection implements
+// ShiftRows. The state is kept in four 32 bit words (one word per column).
+
+static uint32_t load_word(const u_int8* p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void store_word(u_int8* p, uint32_t w)
+{
+  p[0] = (u_int8)w;
+  p[1] = (u_int8)(w >> 8);
+  p[2] = (u_int8)(w >> 16);
+  p[3] = (u_int8)(w >> 24);
+}
+
+// Cipher is the main function that encrypts the PlainText.
+static void Cipher(state_t* state, const u_int8* RoundKey)
+{
+  u_int8 round, c;
+  uint32_t s[4], t[4];
+#ifndef DISABLE_BENCH_MARKING_ENCRYPT
+  int  Begin_Time, End_Time;
+#endif // DISABLE_BENCH_MARKING_ENCRYPT
+
+  // Add the First round key to the state before starting the rounds.
+  for (c = 0; c < 4; ++c)
+  {
+    s[c] = load_word((*state)[c]) ^ load_word(RoundKey + 4 * c);
+  }
+
+  for (round = 1; round < Nr; ++round)
+  {
+#ifndef DISABLE_BENCH_MARKING_ENCRYPT
+    time (Begin_Time);
+#endif // DISABLE_BENCH_MARKING_ENCRYPT
+    for (c = 0; c < 4; ++c)
+    {
+      t[c] = load_word(RoundKey + (round * Nb + c) * 4);
+      PICORV32_AES32ESMI(t[c], t[c], s[c], 0);
+      PICORV32_AES32ESMI(t[c], t[c], s[(c + 1) % 4], 1);
+      PICORV32_AES32ESMI(t[c], t[c], s[(c + 2) % 4], 2);
+      PICORV32_AES32ESMI(t[c], t[c], s[(c + 3) % 4], 3);
+    }
+    for (c = 0; c < 4; ++c)
+    {
+      s[c] = t[c];
+    }
+#ifndef DISABLE_BENCH_MARKING_ENCRYPT
+    time (End_Time);
+    print_str("aes32esmi round total cycles:");
+    print_dec(End_Time - Begin_Time);
+    print_str(", Begin cycles:");
+    print_dec(Begin_Time);
+    print_str(", End cycles:");
+    print_dec(End_Time);
+    print_str("\n");
+#endif // DISABLE_BENCH_MARKING_ENCRYPT
+  }
+
+  // Last one without MixColumns()
+  for (c = 0; c < 4; ++c)
+  {
+    t[c] = load_word(RoundKey + (Nr * Nb + c) * 4);
+    PICORV32_AES32ESI(t[c], t[c], s[c], 0);
+    PICORV32_AES32ESI(t[c], t[c], s[(c + 1) % 4], 1);
+    PICORV32_AES32ESI(t[c], t[c], s[(c + 2) % 4], 2);
+    PICORV32_AES32ESI(t[c], t[c], s[(c + 3) % 4], 3);
+  }
+  for (c = 0; c < 4; ++c)
+  {
+    store_word((*state)[c], t[c]);
+  }
+}
+
+// InvMixColumns of a round key word, needed for the equivalent inverse
+// cipher: SubWord with aes32esi, then InvSubBytes and InvMixColumns with
+// aes32dsmi.
+static uint32_t InvMixColumnsWord(uint32_t w)
+{
+  uint32_t t = 0, r = 0;
+
+  PICORV32_AES32ESI(t, t, w, 0);
+  PICORV32_AES32ESI(t, t, w, 1);
+  PICORV32_AES32ESI(t, t, w, 2);
+  PICORV32_AES32ESI(t, t, w, 3);
+  PICORV32_AES32DSMI(r, r, t, 0);
+  PICORV32_AES32DSMI(r, r, t, 1);
+  PICORV32_AES32DSMI(r, r, t, 2);
+  PICORV32_AES32DSMI(r, r, t, 3);
+  return r;
+}
+
+static void InvCipher(state_t* state, const u_int8* RoundKey)
+{
+  u_int8 round, c;
+  uint32_t s[4], t[4];
+#ifndef DISABLE_BENCH_MARKING_DECRYPT
+  int  Begin_Time, End_Time;
+#endif // DISABLE_BENCH_MARKING_DECRYPT
+
+  // Add the First round key to the state before starting the rounds.
+  for (c = 0; c < 4; ++c)
+  {
+    s[c] = load_word((*state)[c]) ^ load_word(RoundKey + (Nr * Nb + c) * 4);
+  }
+
+  for (round = (Nr - 1); round > 0; --round)
+  {
+#ifndef DISABLE_BENCH_MARKING_DECRYPT
+    time (Begin_Time);
+#endif // DISABLE_BENCH_MARKING_DECRYPT
+    for (c = 0; c < 4; ++c)
+    {
+      t[c] = InvMixColumnsWord(load_word(RoundKey + (round * Nb + c) * 4));
+      PICORV32_AES32DSMI(t[c], t[c], s[c], 0);
+      PICORV32_AES32DSMI(t[c], t[c], s[(c + 3) % 4], 1);
+      PICORV32_AES32DSMI(t[c], t[c], s[(c + 2) % 4], 2);
+      PICORV32_AES32DSMI(t[c], t[c], s[(c + 1) % 4], 3);
+    }
+    for (c = 0; c < 4; ++c)
+    {
+      s[c] = t[c];
+    }
+#ifndef DISABLE_BENCH_MARKING_DECRYPT
+    time (End_Time);
+    print_str("aes32dsmi round total cycles:");
+    print_dec(End_Time - Begin_Time);
+    print_str(", Begin cycles:");
+    print_dec(Begin_Time);
+    print_str(", End cycles:");
+    print_dec(End_Time);
+    print_str("\n");
+#endif // DISABLE_BENCH_MARKING_DECRYPT
+  }
+
+  // Last one without InvMixColumn()
+  for (c = 0; c < 4; ++c)
+  {
+    t[c] = load_word(RoundKey + c * 4);
+    PICORV32_AES32DSI(t[c], t[c], s[c], 0);
+    PICORV32_AES32DSI(t[c], t[c], s[(c + 3) % 4], 1);
+    PICORV32_AES32DSI(t[c], t[c], s[(c + 2) % 4], 2);
+    PICORV32_AES32DSI(t[c], t[c], s[(c + 1) % 4], 3);
+  }
+  for (c = 0; c < 4; ++c)
+  {
+    store_word((*state)[c], t[c]);
+  }
+}
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
 
 /*****************************************************************************/
@@ -896,6 +1060,8 @@ void hello(void)
 
 	print_str("\nhello world\n");
 	print_str("TIMA:call your custom code here\n");
-  call_custom_instruction_aes128();
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+  call_custom_instruction_aes32();
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
@@ -1,7 +1,19 @@
 #include "ntt.h"
+#include "ntt_engine.h"
 #include "params.h"
+#include "picorv32_tcm.h"
 #include "reduce.h"
 #include <stdint.h>
+
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+//#define DISABLE_HWLOOP
+#if defined(DISABLE_CUSTOM_INSTRUCTION) && !defined(DISABLE_HWLOOP)
+#define DISABLE_HWLOOP // the loop bodies use kyber_ct and kyber_gs
+#endif
 #define DISABLE_BENCH_MARKING_L4
 #ifndef DISABLE_BENCH_MARKING_L4
 #include <stdio.h>
@@ -45,7 +57,7 @@ void init_ntt() {
 }
 */
 
-const int16_t PQCLEAN_KYBER1024_CLEAN_zetas[128] = {
+PICORV32_TCM_CONST const int16_t PQCLEAN_KYBER1024_CLEAN_zetas[128] = {
     -1044,  -758,  -359, -1517,  1493,  1422,   287,   202,
     -171,   622,  1577,   182,   962, -1202, -1474,  1468,
     573, -1325,   264,   383,  -829,  1458, -1602,  -130,
@@ -78,6 +90,74 @@ static int16_t fqmul(int16_t a, int16_t b) {
     return PQCLEAN_KYBER1024_CLEAN_montgomery_reduce((int32_t)a * b);
 }
 
+#ifndef DISABLE_HWLOOP
+/*************************************************
+* Name:        ct_hwloop
+*
+* Description: One block of Cooley-Tukey butterflies of the NTT,
+*              (r[j], r[j + len]) for j = 0..len-1, as a hardware loop
+*              (ENABLE_HWLOOP) around kyber_ct
+*
+* Arguments:   - int16_t *r: pointer to the first coefficient of the block
+*              - unsigned int len: distance of the butterfly inputs
+*              - int16_t zeta: twiddle factor (Montgomery domain)
+**************************************************/
+static void ct_hwloop(int16_t *r, unsigned int len, int16_t zeta) {
+    int16_t *s = r + len;
+    uint32_t a, b;
+
+    __asm__ volatile (
+        PICORV32_HWLOOP_BEGIN("%[len]", 10)
+        "lhu  %[a], 0(%[r])\n\t"
+        "lhu  %[b], 0(%[s])\n\t"
+        "slli %[b], %[b], 16\n\t"
+        "or   %[a], %[a], %[b]\n\t"
+        ".insn r 0x2b, 2, 2, %[a], %[a], %[zeta]\n\t" // kyber_ct
+        "sh   %[a], 0(%[r])\n\t"
+        "srli %[a], %[a], 16\n\t"
+        "sh   %[a], 0(%[s])\n\t"
+        "addi %[r], %[r], 2\n\t"
+        "addi %[s], %[s], 2\n\t"
+        PICORV32_HWLOOP_END
+        : [r] "+r"(r), [s] "+r"(s), [a] "=&r"(a), [b] "=&r"(b)
+        : [len] "r"(len), [zeta] "r"((int32_t)zeta)
+        : "memory");
+}
+
+/*************************************************
+* Name:        gs_hwloop
+*
+* Description: One block of Gentleman-Sande butterflies of the inverse NTT,
+*              (r[j], r[j + len]) for j = 0..len-1, as a hardware loop
+*              (ENABLE_HWLOOP) around kyber_gs
+*
+* Arguments:   - int16_t *r: pointer to the first coefficient of the block
+*              - unsigned int len: distance of the butterfly inputs
+*              - int16_t zeta: twiddle factor (Montgomery domain)
+**************************************************/
+static void gs_hwloop(int16_t *r, unsigned int len, int16_t zeta) {
+    int16_t *s = r + len;
+    uint32_t a, b;
+
+    __asm__ volatile (
+        PICORV32_HWLOOP_BEGIN("%[len]", 10)
+        "lhu  %[a], 0(%[r])\n\t"
+        "lhu  %[b], 0(%[s])\n\t"
+        "slli %[b], %[b], 16\n\t"
+        "or   %[a], %[a], %[b]\n\t"
+        ".insn r 0x2b, 3, 2, %[a], %[a], %[zeta]\n\t" // kyber_gs
+        "sh   %[a], 0(%[r])\n\t"
+        "srli %[a], %[a], 16\n\t"
+        "sh   %[a], 0(%[s])\n\t"
+        "addi %[r], %[r], 2\n\t"
+        "addi %[s], %[s], 2\n\t"
+        PICORV32_HWLOOP_END
+        : [r] "+r"(r), [s] "+r"(s), [a] "=&r"(a), [b] "=&r"(b)
+        : [len] "r"(len), [zeta] "r"((int32_t)zeta)
+        : "memory");
+}
+#endif // DISABLE_HWLOOP
+
 /*************************************************
 * Name:        PQCLEAN_KYBER1024_CLEAN_ntt
 *
@@ -88,7 +168,14 @@ static int16_t fqmul(int16_t a, int16_t b) {
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_ntt(int16_t r[256]) {
     unsigned int len, start, j, k;
-    int16_t t, zeta;
+#ifdef DISABLE_HWLOOP
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+    uint32_t ab;
+#else
+    int16_t t;
+#endif // DISABLE_CUSTOM_INSTRUCTION
+#endif // DISABLE_HWLOOP
+    int16_t zeta;
  #ifndef DISABLE_BENCH_MARKING_L4
     long            Begin_Time=0,
                 End_Time=0;
@@ -102,11 +189,22 @@ void PQCLEAN_KYBER1024_CLEAN_ntt(int16_t r[256]) {
     for (len = 128; len >= 2; len >>= 1) {
         for (start = 0; start < 256; start = j + len) {
             zeta = PQCLEAN_KYBER1024_CLEAN_zetas[k++];
+#ifndef DISABLE_HWLOOP
+            ct_hwloop(&r[start], len, zeta);
+            j = start + len;
+#else
             for (j = start; j < start + len; j++) {
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+                ab = picorv32_kyber_ct(picorv32_pack16(r[j], r[j + len]), zeta);
+                r[j] = (int16_t)ab;
+                r[j + len] = (int16_t)(ab >> 16);
+#else
                 t = fqmul(zeta, r[j + len]);
                 r[j + len] = r[j] - t;
                 r[j] = r[j] + t;
+#endif // DISABLE_CUSTOM_INSTRUCTION
             }
+#endif // DISABLE_HWLOOP
         }
     }
 #ifndef DISABLE_BENCH_MARKING_L4
@@ -126,19 +224,37 @@ void PQCLEAN_KYBER1024_CLEAN_ntt(int16_t r[256]) {
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_invntt(int16_t r[256]) {
     unsigned int start, len, j, k;
-    int16_t t, zeta;
+#ifdef DISABLE_HWLOOP
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+    uint32_t ab;
+#else
+    int16_t t;
+#endif // DISABLE_CUSTOM_INSTRUCTION
+#endif // DISABLE_HWLOOP
+    int16_t zeta;
     const int16_t f = 1441; // mont^2/128
 
     k = 127;
     for (len = 2; len <= 128; len <<= 1) {
         for (start = 0; start < 256; start = j + len) {
             zeta = PQCLEAN_KYBER1024_CLEAN_zetas[k--];
+#ifndef DISABLE_HWLOOP
+            gs_hwloop(&r[start], len, zeta);
+            j = start + len;
+#else
             for (j = start; j < start + len; j++) {
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+                ab = picorv32_kyber_gs(picorv32_pack16(r[j], r[j + len]), zeta);
+                r[j] = (int16_t)ab;
+                r[j + len] = (int16_t)(ab >> 16);
+#else
                 t = r[j];
                 r[j] = PQCLEAN_KYBER1024_CLEAN_barrett_reduce(t + r[j + len]);
                 r[j + len] = r[j + len] - t;
                 r[j + len] = fqmul(zeta, r[j + len]);
+#endif // DISABLE_CUSTOM_INSTRUCTION
             }
+#endif // DISABLE_HWLOOP
         }
     }
 
@@ -159,9 +275,29 @@ void PQCLEAN_KYBER1024_CLEAN_invntt(int16_t r[256]) {
 *              - int16_t zeta: integer defining the reduction polynomial
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_basemul(int16_t r[2], const int16_t a[2], const int16_t b[2], int16_t zeta) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     r[0]  = fqmul(a[1], b[1]);
     r[0]  = fqmul(r[0], zeta);
     r[0] += fqmul(a[0], b[0]);
     r[1]  = fqmul(a[0], b[1]);
     r[1] += fqmul(a[1], b[0]);
+#else
+    r[0] = picorv32_kyber_mac(picorv32_kyber_mac(a[1], b[1], 0), zeta, picorv32_kyber_mac(a[0], b[0], 0));
+    r[1] = picorv32_kyber_mac(a[0], b[1], picorv32_kyber_mac(a[1], b[0], 0));
+#endif // DISABLE_CUSTOM_INSTRUCTION
+}
+
+/*************************************************
+* Name:        PQCLEAN_KYBER1024_CLEAN_ntt_engine_init
+*
+* Description: Loads the zetas into the NTT engine (picosoc/ntt_engine.v)
+*              on first use
+**************************************************/
+void PQCLEAN_KYBER1024_CLEAN_ntt_engine_init(void) {
+    static int loaded = 0;
+
+    if (!loaded) {
+        ntt_engine_setup16(PQCLEAN_KYBER1024_CLEAN_zetas, 128);
+        loaded = 1;
+    }
 }
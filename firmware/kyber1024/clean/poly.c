@@ -5,6 +5,16 @@
 #include "reduce.h"
 #include "symmetric.h"
 #include <stdint.h>
+
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+//#define ENABLE_NTT_ENGINE
+#ifdef ENABLE_NTT_ENGINE
+#include "ntt_engine.h"
+#endif // ENABLE_NTT_ENGINE
 #define DISABLE_BENCH_MARKING_L3
 #ifndef DISABLE_BENCH_MARKING_L3
 #include <stdio.h>
@@ -26,11 +36,16 @@
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], const poly *a) {
     unsigned int i, j;
-    int32_t u;
     uint32_t d0;
     uint8_t t[8];
+#ifdef DISABLE_CUSTOM_INSTRUCTION
+    int32_t u;
+#else
+    const picorv32_v2i16 *aa = (const picorv32_v2i16 *)a->coeffs;
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
     for (i = 0; i < KYBER_N / 8; i++) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         for (j = 0; j < 8; j++) {
             // map to positive standard representatives
             u  = a->coeffs[8 * i + j];
@@ -42,6 +57,13 @@ void PQCLEAN_KYBER1024_CLEAN_poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES],
             d0 >>= 27;
             t[j] = d0 & 0x1f;
         }
+#else
+        for (j = 0; j < 4; j++) {
+            d0 = picorv32_kyber_compress(aa[4 * i + j], 5);
+            t[2 * j + 0] = (uint8_t)d0;
+            t[2 * j + 1] = (uint8_t)(d0 >> 16);
+        }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
         r[0] = (t[0] >> 0) | (t[1] << 5);
         r[1] = (t[1] >> 3) | (t[2] << 2) | (t[3] << 7);
@@ -67,6 +89,9 @@ void PQCLEAN_KYBER1024_CLEAN_poly_decompress(poly *r, const uint8_t a[KYBER_POLY
 
     size_t j;
     uint8_t t[8];
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+#endif // DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N / 8; i++) {
         t[0] = (a[0] >> 0);
         t[1] = (a[0] >> 5) | (a[1] << 3);
@@ -78,9 +103,15 @@ void PQCLEAN_KYBER1024_CLEAN_poly_decompress(poly *r, const uint8_t a[KYBER_POLY
         t[7] = (a[4] >> 3);
         a += 5;
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         for (j = 0; j < 8; j++) {
             r->coeffs[8 * i + j] = ((uint32_t)(t[j] & 31) * KYBER_Q + 16) >> 5;
         }
+#else
+        for (j = 0; j < 4; j++) {
+            rr[4 * i + j] = picorv32_kyber_decompress(t[2 * j] | ((uint32_t)t[2 * j + 1] << 16), 5);
+        }
+#endif // DISABLE_CUSTOM_INSTRUCTION
     }
 }
 
@@ -161,6 +192,7 @@ void PQCLEAN_KYBER1024_CLEAN_poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], cons
 
     for (i = 0; i < KYBER_N / 8; i++) {
         msg[i] = 0;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         for (j = 0; j < 8; j++) {
             t  = a->coeffs[8 * i + j];
             // t += ((int16_t)t >> 15) & KYBER_Q;
@@ -172,6 +204,12 @@ void PQCLEAN_KYBER1024_CLEAN_poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], cons
             t &= 1;
             msg[i] |= t << j;
         }
+#else
+        for (j = 0; j < 4; j++) {
+            t = picorv32_kyber_compress(((const picorv32_v2i16 *)a->coeffs)[4 * i + j], 1);
+            msg[i] |= (uint8_t)((t | (t >> 15)) << (2 * j));
+        }
+#endif // DISABLE_CUSTOM_INSTRUCTION
     }
 }
 
@@ -228,7 +266,14 @@ void PQCLEAN_KYBER1024_CLEAN_poly_ntt(poly *r) {
  #ifndef DISABLE_BENCH_MARKING_L3
     time (Begin_Time);
  #endif // DISABLE_BENCH_MARKING_L3
+#ifndef ENABLE_NTT_ENGINE
     PQCLEAN_KYBER1024_CLEAN_ntt(r->coeffs);
+#else
+    PQCLEAN_KYBER1024_CLEAN_ntt_engine_init();
+    ntt_engine_load16(0, r->coeffs, KYBER_N);
+    ntt_engine_start(NTT_ENGINE_OP_NTT, 0);
+    ntt_engine_wait();
+#endif // ENABLE_NTT_ENGINE
 #ifndef DISABLE_BENCH_MARKING_L3
     time (End_Time);
     fprintf(stdout, "L3: PQCLEAN_KYBER1024_CLEAN_ntt cycles = %ld, begin:%ld, end:%ld\n", End_Time - Begin_Time,Begin_Time,End_Time);
@@ -236,7 +281,12 @@ void PQCLEAN_KYBER1024_CLEAN_poly_ntt(poly *r) {
  #ifndef DISABLE_BENCH_MARKING_L3
     time (Begin_Time);
  #endif // DISABLE_BENCH_MARKING_L3
+#ifndef ENABLE_NTT_ENGINE
     PQCLEAN_KYBER1024_CLEAN_poly_reduce(r);
+#else
+    ntt_engine_start(NTT_ENGINE_OP_REDUCE, 0);
+    ntt_engine_store16(r->coeffs, 0, KYBER_N);
+#endif // ENABLE_NTT_ENGINE
 #ifndef DISABLE_BENCH_MARKING_L3
     time (End_Time);
     fprintf(stdout, "L3: PQCLEAN_KYBER1024_CLEAN_poly_reduce cycles = %ld, begin:%ld, end:%ld\n", End_Time - Begin_Time,Begin_Time,End_Time);
@@ -253,7 +303,14 @@ void PQCLEAN_KYBER1024_CLEAN_poly_ntt(poly *r) {
 * Arguments:   - uint16_t *a: pointer to in/output polynomial
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_poly_invntt_tomont(poly *r) {
+#ifndef ENABLE_NTT_ENGINE
     PQCLEAN_KYBER1024_CLEAN_invntt(r->coeffs);
+#else
+    PQCLEAN_KYBER1024_CLEAN_ntt_engine_init();
+    ntt_engine_load16(0, r->coeffs, KYBER_N);
+    ntt_engine_start(NTT_ENGINE_OP_INVNTT, 0);
+    ntt_engine_store16(r->coeffs, 0, KYBER_N);
+#endif // ENABLE_NTT_ENGINE
 }
 
 /*************************************************
@@ -284,9 +341,20 @@ void PQCLEAN_KYBER1024_CLEAN_poly_basemul_montgomery(poly *r, const poly *a, con
 void PQCLEAN_KYBER1024_CLEAN_poly_tomont(poly *r) {
     size_t i;
     const int16_t f = (1ULL << 32) % KYBER_Q;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = PQCLEAN_KYBER1024_CLEAN_montgomery_reduce((int32_t)r->coeffs[i] * f);
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    const uint32_t ff = picorv32_pack16(f, f);
+    uint32_t a;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        a = rr[i];
+        rr[i] = picorv32_pkbb16((uint16_t)picorv32_kyber_mont(picorv32_smtt16(a, ff)),
+                                (uint16_t)picorv32_kyber_mont(picorv32_smbb16(a, ff)));
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -299,9 +367,16 @@ void PQCLEAN_KYBER1024_CLEAN_poly_tomont(poly *r) {
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_poly_reduce(poly *r) {
     size_t i;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = PQCLEAN_KYBER1024_CLEAN_barrett_reduce(r->coeffs[i]);
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        rr[i] = picorv32_kyber_barrett(rr[i]);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -315,9 +390,18 @@ void PQCLEAN_KYBER1024_CLEAN_poly_reduce(poly *r) {
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_poly_add(poly *r, const poly *a, const poly *b) {
     size_t i;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = a->coeffs[i] + b->coeffs[i];
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    const picorv32_v2i16 *aa = (const picorv32_v2i16 *)a->coeffs;
+    const picorv32_v2i16 *bb = (const picorv32_v2i16 *)b->coeffs;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        rr[i] = picorv32_add16(aa[i], bb[i]);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -331,7 +415,16 @@ void PQCLEAN_KYBER1024_CLEAN_poly_add(poly *r, const poly *a, const poly *b) {
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_poly_sub(poly *r, const poly *a, const poly *b) {
     size_t i;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = a->coeffs[i] - b->coeffs[i];
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    const picorv32_v2i16 *aa = (const picorv32_v2i16 *)a->coeffs;
+    const picorv32_v2i16 *bb = (const picorv32_v2i16 *)b->coeffs;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        rr[i] = picorv32_sub16(aa[i], bb[i]);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
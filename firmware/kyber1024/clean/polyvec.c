@@ -3,6 +3,17 @@
 #include "polyvec.h"
 #include <stdint.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+//#define ENABLE_NTT_ENGINE
+#ifdef ENABLE_NTT_ENGINE
+#include "ntt.h"
+#include "ntt_engine.h"
+#endif // ENABLE_NTT_ENGINE
+
 /*************************************************
 * Name:        PQCLEAN_KYBER1024_CLEAN_polyvec_compress
 *
@@ -14,11 +25,16 @@
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], const polyvec *a) {
     unsigned int i, j, k;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     uint64_t d0;
+#else
+    uint32_t w;
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
     uint16_t t[8];
     for (i = 0; i < KYBER_K; i++) {
         for (j = 0; j < KYBER_N / 8; j++) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
             for (k = 0; k < 8; k++) {
                 t[k]  = a->vec[i].coeffs[8 * j + k];
                 t[k] += ((int16_t)t[k] >> 15) & KYBER_Q;
@@ -31,6 +47,13 @@ void PQCLEAN_KYBER1024_CLEAN_polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDB
                 t[k] = d0 & 0x7ff;
 
             }
+#else
+            for (k = 0; k < 4; k++) {
+                w = picorv32_kyber_compress(((const picorv32_v2i16 *)a->vec[i].coeffs)[4 * j + k], 11);
+                t[2 * k + 0] = (uint16_t)w;
+                t[2 * k + 1] = (uint16_t)(w >> 16);
+            }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
             r[ 0] = (uint8_t)(t[0] >>  0);
             r[ 1] = (uint8_t)((t[0] >>  8) | (t[1] << 3));
@@ -74,9 +97,16 @@ void PQCLEAN_KYBER1024_CLEAN_polyvec_decompress(polyvec *r, const uint8_t a[KYBE
             t[7] = (a[9] >> 5) | ((uint16_t)a[10] << 3);
             a += 11;
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
             for (k = 0; k < 8; k++) {
                 r->vec[i].coeffs[8 * j + k] = ((uint32_t)(t[k] & 0x7FF) * KYBER_Q + 1024) >> 11;
             }
+#else
+            for (k = 0; k < 4; k++) {
+                ((picorv32_v2i16 *)r->vec[i].coeffs)[4 * j + k] =
+                    picorv32_kyber_decompress(t[2 * k] | ((uint32_t)t[2 * k + 1] << 16), 11);
+            }
+#endif // DISABLE_CUSTOM_INSTRUCTION
         }
     }
 }
@@ -155,6 +185,7 @@ void PQCLEAN_KYBER1024_CLEAN_polyvec_invntt_tomont(polyvec *r) {
 **************************************************/
 void PQCLEAN_KYBER1024_CLEAN_polyvec_basemul_acc_montgomery(poly *r, const polyvec *a, const polyvec *b) {
     unsigned int i;
+#ifndef ENABLE_NTT_ENGINE
     poly t;
 
     PQCLEAN_KYBER1024_CLEAN_poly_basemul_montgomery(r, &a->vec[0], &b->vec[0]);
@@ -164,6 +195,16 @@ void PQCLEAN_KYBER1024_CLEAN_polyvec_basemul_acc_montgomery(poly *r, const polyv
     }
 
     PQCLEAN_KYBER1024_CLEAN_poly_reduce(r);
+#else
+    PQCLEAN_KYBER1024_CLEAN_ntt_engine_init();
+    for (i = 0; i < KYBER_K; i++) {
+        ntt_engine_load16(0, a->vec[i].coeffs, KYBER_N);
+        ntt_engine_load16(1, b->vec[i].coeffs, KYBER_N);
+        ntt_engine_start(i == 0 ? NTT_ENGINE_OP_MUL : NTT_ENGINE_OP_MAC, 0);
+    }
+    ntt_engine_start(NTT_ENGINE_OP_REDUCE, 2);
+    ntt_engine_store16(r->coeffs, 2, KYBER_N);
+#endif // ENABLE_NTT_ENGINE
 }
 
 /*************************************************
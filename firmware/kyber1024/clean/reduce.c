@@ -7,6 +7,7 @@
 #include <stdio.h>
 #endif // DISABLE_BENCH_MARKING_L4
 #ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
 #define time(cycles)\
 {\
 	__asm__ volatile ("rdcycle %0" : "=r"(cycles));\
@@ -72,7 +73,7 @@ int16_t PQCLEAN_KYBER1024_CLEAN_montgomery_reduce(int32_t a) {
 #ifdef DISABLE_CUSTOM_INSTRUCTION
     t = (a - (int32_t)t * KYBER_Q) >> 16;
 #else // DISABLE_CUSTOM_INSTRUCTION
-    __asm__ volatile ("kyber %0, %1,%2\n" :"=r"(t):"r"(a),"r"(t):);
+    t = picorv32_kyber_mont(a);
 #endif // DISABLE_CUSTOM_INSTRUCTION
 #ifndef DISABLE_BENCH_MARKING_L4
     time (End_Time);
@@ -96,6 +97,7 @@ int16_t PQCLEAN_KYBER1024_CLEAN_montgomery_reduce(int32_t a) {
 * Returns:     integer in {-(q-1)/2,...,(q-1)/2} congruent to a modulo q.
 **************************************************/
 int16_t PQCLEAN_KYBER1024_CLEAN_barrett_reduce(int16_t a) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     int16_t t;
     const int16_t v = ((1 << 26) + KYBER_Q / 2) / KYBER_Q;
  #ifndef DISABLE_BENCH_MARKING_L4
@@ -119,4 +121,7 @@ int16_t PQCLEAN_KYBER1024_CLEAN_barrett_reduce(int16_t a) {
     t *= KYBER_Q;
 
     return a - t;
+#else
+    return (int16_t)picorv32_kyber_barrett((uint16_t)a);
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
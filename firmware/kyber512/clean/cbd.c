@@ -2,6 +2,11 @@
 #include "params.h"
 #include <stdint.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 /*************************************************
 * Name:        load32_littleendian
 *
@@ -51,6 +56,7 @@ static uint32_t load24_littleendian(const uint8_t x[3]) {
 *              - const uint8_t *buf: pointer to input byte array
 **************************************************/
 static void cbd2(poly *r, const uint8_t buf[2 * KYBER_N / 4]) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     unsigned int i, j;
     uint32_t t, d;
     int16_t a, b;
@@ -66,6 +72,19 @@ static void cbd2(poly *r, const uint8_t buf[2 * KYBER_N / 4]) {
             r->coeffs[8 * i + j] = a - b;
         }
     }
+#else
+    unsigned int i;
+    uint32_t t;
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+
+    for (i = 0; i < KYBER_N / 8; i++) {
+        t = load32_littleendian(buf + 4 * i);
+        rr[4 * i + 0] = picorv32_kyber_cbd2(t, 0);
+        rr[4 * i + 1] = picorv32_kyber_cbd2(t, 1);
+        rr[4 * i + 2] = picorv32_kyber_cbd2(t, 2);
+        rr[4 * i + 3] = picorv32_kyber_cbd2(t, 3);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -80,6 +99,7 @@ static void cbd2(poly *r, const uint8_t buf[2 * KYBER_N / 4]) {
 *              - const uint8_t *buf: pointer to input byte array
 **************************************************/
 static void cbd3(poly *r, const uint8_t buf[3 * KYBER_N / 4]) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     unsigned int i, j;
     uint32_t t, d;
     int16_t a, b;
@@ -96,6 +116,17 @@ static void cbd3(poly *r, const uint8_t buf[3 * KYBER_N / 4]) {
             r->coeffs[4 * i + j] = a - b;
         }
     }
+#else
+    unsigned int i;
+    uint32_t t;
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+
+    for (i = 0; i < KYBER_N / 4; i++) {
+        t = load24_littleendian(buf + 3 * i);
+        rr[2 * i + 0] = picorv32_kyber_cbd3(t, 0);
+        rr[2 * i + 1] = picorv32_kyber_cbd3(t, 1);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 void PQCLEAN_KYBER512_CLEAN_poly_cbd_eta1(poly *r, const uint8_t buf[KYBER_ETA1 * KYBER_N / 4]) {
@@ -1,6 +1,7 @@
 #include "indcpa.h"
 #include "ntt.h"
 #include "params.h"
+#include "picorv32_tcm.h"
 #include "poly.h"
 #include "polyvec.h"
 #include "randombytes.h"
@@ -9,6 +10,11 @@
 #include <stdint.h>
 #include <string.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 #define DISABLE_BENCH_MARKING_L2
 #ifndef DISABLE_BENCH_MARKING_L2
 #include <stdio.h>
@@ -127,8 +133,22 @@ static unsigned int rej_uniform(int16_t *r,
                                 unsigned int buflen) {
     unsigned int ctr, pos;
     uint16_t val0, val1;
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+    uint32_t w;
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
     ctr = pos = 0;
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+    while (ctr + 2 <= len && pos + 3 <= buflen) {
+        w = picorv32_kyber_rej(buf[pos + 0] | ((uint32_t)buf[pos + 1] << 8) | ((uint32_t)buf[pos + 2] << 16));
+        pos += 3;
+
+        /* both slots are written, ctr only advances over the accepted ones */
+        r[ctr + 0] = (int16_t)(w & 0xFFF);
+        r[ctr + 1] = (int16_t)((w >> 16) & 0xFFF);
+        ctr += w >> 30;
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
     while (ctr < len && pos + 3 <= buflen) {
         val0 = ((buf[pos + 0] >> 0) | ((uint16_t)buf[pos + 1] << 8)) & 0xFFF;
         val1 = ((buf[pos + 1] >> 4) | ((uint16_t)buf[pos + 2] << 4)) & 0xFFF;
@@ -267,7 +287,8 @@ void PQCLEAN_KYBER512_CLEAN_indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
     unsigned int i;
     uint8_t seed[KYBER_SYMBYTES];
     uint8_t nonce = 0;
-    polyvec sp, pkpv, ep, at[KYBER_K], b;
+    static PICORV32_TCM polyvec sp, b;
+    polyvec pkpv, ep, at[KYBER_K];
     poly v, k, epp;
  #ifndef DISABLE_BENCH_MARKING_L2
     long            Begin_Time=0,
@@ -413,7 +434,7 @@ void PQCLEAN_KYBER512_CLEAN_indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
 void PQCLEAN_KYBER512_CLEAN_indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
                                        const uint8_t c[KYBER_INDCPA_BYTES],
                                        const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]) {
-    polyvec b, skpv;
+    static PICORV32_TCM polyvec b, skpv;
     poly v, mp;
  #ifndef DISABLE_BENCH_MARKING_L2
     long            Begin_Time=0,
@@ -9,7 +9,7 @@
  */
 typedef struct {
     int16_t coeffs[KYBER_N];
-} poly;
+} __attribute__((aligned(4))) poly; /* aligned for packed 2x16-bit accesses */
 
 void PQCLEAN_KYBER512_CLEAN_poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], const poly *a);
 void PQCLEAN_KYBER512_CLEAN_poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES]);
@@ -4,6 +4,7 @@
 
 //#define DISABLE_CUSTOM_INSTRUCTION
 #ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
 #define time(cycles)\
 {\
 	__asm__ volatile ("rdcycle %0" : "=r"(cycles));\
@@ -27,7 +28,7 @@ int16_t PQCLEAN_KYBER512_CLEAN_montgomery_reduce(int32_t a) {
     t = (int16_t)a * QINV;
     t = (a - (int32_t)t * KYBER_Q) >> 16;
 #else
-    __asm__ volatile ("kyber %0, %1,%2\n" :"=r"(t):"r"(a),"r"(t):);
+    t = picorv32_kyber_mont(a);
 #endif // DISABLE_CUSTOM_INSTRUCTION
     return t;
 }
@@ -43,10 +44,14 @@ int16_t PQCLEAN_KYBER512_CLEAN_montgomery_reduce(int32_t a) {
 * Returns:     integer in {-(q-1)/2,...,(q-1)/2} congruent to a modulo q.
 **************************************************/
 int16_t PQCLEAN_KYBER512_CLEAN_barrett_reduce(int16_t a) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     int16_t t;
     const int16_t v = ((1 << 26) + KYBER_Q / 2) / KYBER_Q;
 
     t  = ((int32_t)v * a + (1 << 25)) >> 26;
     t *= KYBER_Q;
     return a - t;
+#else
+    return (int16_t)picorv32_kyber_barrett((uint16_t)a);
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
@@ -11,4 +11,6 @@ void PQCLEAN_KYBER768_CLEAN_invntt(int16_t r[256]);
 
 void PQCLEAN_KYBER768_CLEAN_basemul(int16_t r[2], const int16_t a[2], const int16_t b[2], int16_t zeta);
 
+void PQCLEAN_KYBER768_CLEAN_ntt_engine_init(void);
+
 #endif
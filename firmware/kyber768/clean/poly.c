@@ -6,6 +6,16 @@
 #include "symmetric.h"
 #include <stdint.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+//#define ENABLE_NTT_ENGINE
+#ifdef ENABLE_NTT_ENGINE
+#include "ntt_engine.h"
+#endif // ENABLE_NTT_ENGINE
+
 /*************************************************
 * Name:        PQCLEAN_KYBER768_CLEAN_poly_compress
 *
@@ -16,7 +26,9 @@
 *              - const poly *a: pointer to input polynomial
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], const poly *a) {
-    unsigned int i, j;
+    unsigned int i;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
+    unsigned int j;
     int32_t u;
     uint32_t d0;
     uint8_t t[8];
@@ -40,6 +52,15 @@ void PQCLEAN_KYBER768_CLEAN_poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES],
         r[3] = t[6] | (t[7] << 4);
         r += 4;
     }
+#else
+    const picorv32_v2i16 *aa = (const picorv32_v2i16 *)a->coeffs;
+    uint32_t t;
+
+    for (i = 0; i < KYBER_N / 2; i++) {
+        t = picorv32_kyber_compress(aa[i], 4);
+        r[i] = (uint8_t)(t | (t >> 12));
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -55,11 +76,18 @@ void PQCLEAN_KYBER768_CLEAN_poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES],
 void PQCLEAN_KYBER768_CLEAN_poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES]) {
     size_t i;
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N / 2; i++) {
         r->coeffs[2 * i + 0] = (((uint16_t)(a[0] & 15) * KYBER_Q) + 8) >> 4;
         r->coeffs[2 * i + 1] = (((uint16_t)(a[0] >> 4) * KYBER_Q) + 8) >> 4;
         a += 1;
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        rr[i] = picorv32_kyber_decompress(a[i] | ((uint32_t)a[i] << 12), 4);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -139,6 +167,7 @@ void PQCLEAN_KYBER768_CLEAN_poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], const
 
     for (i = 0; i < KYBER_N / 8; i++) {
         msg[i] = 0;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         for (j = 0; j < 8; j++) {
             t  = a->coeffs[8 * i + j];
             // t += ((int16_t)t >> 15) & KYBER_Q;
@@ -150,6 +179,12 @@ void PQCLEAN_KYBER768_CLEAN_poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], const
             t &= 1;
             msg[i] |= t << j;
         }
+#else
+        for (j = 0; j < 4; j++) {
+            t = picorv32_kyber_compress(((const picorv32_v2i16 *)a->coeffs)[4 * i + j], 1);
+            msg[i] |= (uint8_t)((t | (t >> 15)) << (2 * j));
+        }
+#endif // DISABLE_CUSTOM_INSTRUCTION
     }
 }
 
@@ -199,8 +234,16 @@ void PQCLEAN_KYBER768_CLEAN_poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER
 * Arguments:   - uint16_t *r: pointer to in/output polynomial
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_poly_ntt(poly *r) {
+#ifndef ENABLE_NTT_ENGINE
     PQCLEAN_KYBER768_CLEAN_ntt(r->coeffs);
     PQCLEAN_KYBER768_CLEAN_poly_reduce(r);
+#else
+    PQCLEAN_KYBER768_CLEAN_ntt_engine_init();
+    ntt_engine_load16(0, r->coeffs, KYBER_N);
+    ntt_engine_start(NTT_ENGINE_OP_NTT, 0);
+    ntt_engine_start(NTT_ENGINE_OP_REDUCE, 0);
+    ntt_engine_store16(r->coeffs, 0, KYBER_N);
+#endif // ENABLE_NTT_ENGINE
 }
 
 /*************************************************
@@ -213,7 +256,14 @@ void PQCLEAN_KYBER768_CLEAN_poly_ntt(poly *r) {
 * Arguments:   - uint16_t *a: pointer to in/output polynomial
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_poly_invntt_tomont(poly *r) {
+#ifndef ENABLE_NTT_ENGINE
     PQCLEAN_KYBER768_CLEAN_invntt(r->coeffs);
+#else
+    PQCLEAN_KYBER768_CLEAN_ntt_engine_init();
+    ntt_engine_load16(0, r->coeffs, KYBER_N);
+    ntt_engine_start(NTT_ENGINE_OP_INVNTT, 0);
+    ntt_engine_store16(r->coeffs, 0, KYBER_N);
+#endif // ENABLE_NTT_ENGINE
 }
 
 /*************************************************
@@ -244,9 +294,20 @@ void PQCLEAN_KYBER768_CLEAN_poly_basemul_montgomery(poly *r, const poly *a, cons
 void PQCLEAN_KYBER768_CLEAN_poly_tomont(poly *r) {
     size_t i;
     const int16_t f = (1ULL << 32) % KYBER_Q;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = PQCLEAN_KYBER768_CLEAN_montgomery_reduce((int32_t)r->coeffs[i] * f);
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    const uint32_t ff = picorv32_pack16(f, f);
+    uint32_t a;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        a = rr[i];
+        rr[i] = picorv32_pkbb16((uint16_t)picorv32_kyber_mont(picorv32_smtt16(a, ff)),
+                                (uint16_t)picorv32_kyber_mont(picorv32_smbb16(a, ff)));
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -259,9 +320,16 @@ void PQCLEAN_KYBER768_CLEAN_poly_tomont(poly *r) {
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_poly_reduce(poly *r) {
     size_t i;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = PQCLEAN_KYBER768_CLEAN_barrett_reduce(r->coeffs[i]);
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        rr[i] = picorv32_kyber_barrett(rr[i]);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -275,9 +343,18 @@ void PQCLEAN_KYBER768_CLEAN_poly_reduce(poly *r) {
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_poly_add(poly *r, const poly *a, const poly *b) {
     size_t i;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = a->coeffs[i] + b->coeffs[i];
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    const picorv32_v2i16 *aa = (const picorv32_v2i16 *)a->coeffs;
+    const picorv32_v2i16 *bb = (const picorv32_v2i16 *)b->coeffs;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        rr[i] = picorv32_add16(aa[i], bb[i]);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /*************************************************
@@ -291,7 +368,16 @@ void PQCLEAN_KYBER768_CLEAN_poly_add(poly *r, const poly *a, const poly *b) {
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_poly_sub(poly *r, const poly *a, const poly *b) {
     size_t i;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     for (i = 0; i < KYBER_N; i++) {
         r->coeffs[i] = a->coeffs[i] - b->coeffs[i];
     }
+#else
+    picorv32_v2i16 *rr = (picorv32_v2i16 *)r->coeffs;
+    const picorv32_v2i16 *aa = (const picorv32_v2i16 *)a->coeffs;
+    const picorv32_v2i16 *bb = (const picorv32_v2i16 *)b->coeffs;
+    for (i = 0; i < KYBER_N / 2; i++) {
+        rr[i] = picorv32_sub16(aa[i], bb[i]);
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
@@ -3,6 +3,17 @@
 #include "polyvec.h"
 #include <stdint.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+//#define ENABLE_NTT_ENGINE
+#ifdef ENABLE_NTT_ENGINE
+#include "ntt.h"
+#include "ntt_engine.h"
+#endif // ENABLE_NTT_ENGINE
+
 /*************************************************
 * Name:        PQCLEAN_KYBER768_CLEAN_polyvec_compress
 *
@@ -14,11 +25,16 @@
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], const polyvec *a) {
     unsigned int i, j, k;
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     uint64_t d0;
+#else
+    uint32_t w;
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
     uint16_t t[4];
     for (i = 0; i < KYBER_K; i++) {
         for (j = 0; j < KYBER_N / 4; j++) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
             for (k = 0; k < 4; k++) {
                 t[k]  = a->vec[i].coeffs[4 * j + k];
                 t[k] += ((int16_t)t[k] >> 15) & KYBER_Q;
@@ -30,6 +46,13 @@ void PQCLEAN_KYBER768_CLEAN_polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBY
                 d0 >>= 32;
                 t[k] = d0 & 0x3ff;
             }
+#else
+            for (k = 0; k < 2; k++) {
+                w = picorv32_kyber_compress(((const picorv32_v2i16 *)a->vec[i].coeffs)[2 * j + k], 10);
+                t[2 * k + 0] = (uint16_t)w;
+                t[2 * k + 1] = (uint16_t)(w >> 16);
+            }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 
             r[0] = (uint8_t)(t[0] >> 0);
             r[1] = (uint8_t)((t[0] >> 8) | (t[1] << 2));
@@ -63,9 +86,16 @@ void PQCLEAN_KYBER768_CLEAN_polyvec_decompress(polyvec *r, const uint8_t a[KYBER
             t[3] = (a[3] >> 6) | ((uint16_t)a[4] << 2);
             a += 5;
 
+#ifdef DISABLE_CUSTOM_INSTRUCTION
             for (k = 0; k < 4; k++) {
                 r->vec[i].coeffs[4 * j + k] = ((uint32_t)(t[k] & 0x3FF) * KYBER_Q + 512) >> 10;
             }
+#else
+            for (k = 0; k < 2; k++) {
+                ((picorv32_v2i16 *)r->vec[i].coeffs)[2 * j + k] =
+                    picorv32_kyber_decompress(t[2 * k] | ((uint32_t)t[2 * k + 1] << 16), 10);
+            }
+#endif // DISABLE_CUSTOM_INSTRUCTION
         }
     }
 }
@@ -144,6 +174,7 @@ void PQCLEAN_KYBER768_CLEAN_polyvec_invntt_tomont(polyvec *r) {
 **************************************************/
 void PQCLEAN_KYBER768_CLEAN_polyvec_basemul_acc_montgomery(poly *r, const polyvec *a, const polyvec *b) {
     unsigned int i;
+#ifndef ENABLE_NTT_ENGINE
     poly t;
 
     PQCLEAN_KYBER768_CLEAN_poly_basemul_montgomery(r, &a->vec[0], &b->vec[0]);
@@ -153,6 +184,16 @@ void PQCLEAN_KYBER768_CLEAN_polyvec_basemul_acc_montgomery(poly *r, const polyve
     }
 
     PQCLEAN_KYBER768_CLEAN_poly_reduce(r);
+#else
+    PQCLEAN_KYBER768_CLEAN_ntt_engine_init();
+    for (i = 0; i < KYBER_K; i++) {
+        ntt_engine_load16(0, a->vec[i].coeffs, KYBER_N);
+        ntt_engine_load16(1, b->vec[i].coeffs, KYBER_N);
+        ntt_engine_start(i == 0 ? NTT_ENGINE_OP_MUL : NTT_ENGINE_OP_MAC, 0);
+    }
+    ntt_engine_start(NTT_ENGINE_OP_REDUCE, 2);
+    ntt_engine_store16(r->coeffs, 2, KYBER_N);
+#endif // ENABLE_NTT_ENGINE
 }
 
 /*************************************************
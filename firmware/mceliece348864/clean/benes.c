@@ -10,6 +10,8 @@
 #include "params.h"
 #include "transpose.h"
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+
 /* one layer of the benes network */
 static void layer(uint64_t *data, uint64_t *bits, int lgs) {
     int i, j, s;
@@ -29,6 +31,29 @@ static void layer(uint64_t *data, uint64_t *bits, int lgs) {
     }
 }
 
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+/* input: ptr, 64 32-bit words of condition bits */
+/* output: cond[0..31], rows 0..31 of their transpose_64x64; rows 32..63 */
+/*         of that transpose are zero and not used by layer() */
+static void load_cond_transposed(uint64_t *cond, const unsigned char *ptr) {
+    int i;
+
+    uint32_t a[2][32], b[2][32];
+
+    for (i = 0; i < 32; i++) {
+        a[0][i] = load4(ptr + i * 4);
+        a[1][i] = load4(ptr + (i + 32) * 4);
+    }
+
+    transpose_32x32(b[0], a[0]);
+    transpose_32x32(b[1], a[1]);
+
+    for (i = 0; i < 32; i++) {
+        cond[i] = ((uint64_t)b[1][i] << 32) | b[0][i];
+    }
+}
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 /* input: r, sequence of bits to be permuted */
 /*        bits, condition bits of the Benes network */
 /*        rev, 0 for normal application; !0 for inverse */
@@ -61,10 +86,14 @@ void apply_benes(unsigned char *r, const unsigned char *bits, int rev) {
     transpose_64x64(bs, bs);
 
     for (low = 0; low <= 5; low++) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         for (i = 0; i < 64; i++) {
             cond[i] = load4(cond_ptr + i * 4);
         }
         transpose_64x64(cond, cond);
+#else
+        load_cond_transposed(cond, cond_ptr);
+#endif // DISABLE_CUSTOM_INSTRUCTION
         layer(bs, cond, low);
         cond_ptr += inc;
     }
@@ -89,10 +118,14 @@ void apply_benes(unsigned char *r, const unsigned char *bits, int rev) {
     transpose_64x64(bs, bs);
 
     for (low = 5; low >= 0; low--) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
         for (i = 0; i < 64; i++) {
             cond[i] = load4(cond_ptr + i * 4);
         }
         transpose_64x64(cond, cond);
+#else
+        load_cond_transposed(cond, cond_ptr);
+#endif // DISABLE_CUSTOM_INSTRUCTION
         layer(bs, cond, low);
         cond_ptr += inc;
     }
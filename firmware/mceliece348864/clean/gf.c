@@ -6,6 +6,38 @@
 
 #include "params.h"
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+/* use the generic clmul instruction instead of gfmul12 */
+//#define GF_USE_CLMUL
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+
+#ifdef GF_USE_CLMUL
+/* carry-less product, reduced modulo x^12 + x^3 + 1 as in the reference code */
+static inline gf gf_mul_clmul(gf in0, gf in1) {
+    uint32_t tmp = picorv32_clmul(in0, in1);
+    uint32_t t;
+
+    t = tmp & 0x7FC000;
+    tmp ^= t >> 9;
+    tmp ^= t >> 12;
+
+    t = tmp & 0x3000;
+    tmp ^= t >> 9;
+    tmp ^= t >> 12;
+
+    return tmp & ((1 << GFBITS) - 1);
+}
+
+#define gf_mul_fast(in0, in1) gf_mul_clmul((in0), (in1))
+#else
+/* gfmul12 reduces modulo x^12 + x^3 + 1, the field polynomial for GFBITS = 12 */
+#define gf_mul_fast(in0, in1) ((gf) picorv32_gfmul12((in0), (in1)))
+#endif // GF_USE_CLMUL
+#else
+#define gf_mul_fast(in0, in1) gf_mul((in0), (in1))
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
 gf gf_iszero(gf a) {
     uint32_t t = a;
 
@@ -20,6 +52,9 @@ gf gf_add(gf in0, gf in1) {
 }
 
 gf gf_mul(gf in0, gf in1) {
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+    return gf_mul_fast(in0, in1);
+#else
     int i;
 
     uint32_t tmp;
@@ -45,11 +80,15 @@ gf gf_mul(gf in0, gf in1) {
     tmp ^= t >> 12;
 
     return tmp & ((1 << GFBITS) - 1);
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 /* input: field element in */
 /* return: in^2 */
 static inline gf gf_sq(gf in) {
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+    return gf_mul_fast(in, in);
+#else
     const uint32_t B[] = {0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF};
 
     uint32_t x = in;
@@ -69,6 +108,7 @@ static inline gf gf_sq(gf in) {
     x ^= t >> 12;
 
     return x & ((1 << GFBITS) - 1);
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
 
 gf gf_inv(gf in) {
@@ -78,24 +118,24 @@ gf gf_inv(gf in) {
     gf out = in;
 
     out = gf_sq(out);
-    tmp_11 = gf_mul(out, in); // 11
+    tmp_11 = gf_mul_fast(out, in); // 11
 
     out = gf_sq(tmp_11);
     out = gf_sq(out);
-    tmp_1111 = gf_mul(out, tmp_11); // 1111
+    tmp_1111 = gf_mul_fast(out, tmp_11); // 1111
 
     out = gf_sq(tmp_1111);
     out = gf_sq(out);
     out = gf_sq(out);
     out = gf_sq(out);
-    out = gf_mul(out, tmp_1111); // 11111111
+    out = gf_mul_fast(out, tmp_1111); // 11111111
 
     out = gf_sq(out);
     out = gf_sq(out);
-    out = gf_mul(out, tmp_11); // 1111111111
+    out = gf_mul_fast(out, tmp_11); // 1111111111
 
     out = gf_sq(out);
-    out = gf_mul(out, in); // 11111111111
+    out = gf_mul_fast(out, in); // 11111111111
 
     return gf_sq(out); // 111111111110
 }
@@ -103,7 +143,7 @@ gf gf_inv(gf in) {
 /* input: field element den, num */
 /* return: (num/den) */
 gf gf_frac(gf den, gf num) {
-    return gf_mul(gf_inv(den), num);
+    return gf_mul_fast(gf_inv(den), num);
 }
 
 /* input: in0, in1 in GF((2^m)^t)*/
@@ -119,7 +159,7 @@ void GF_mul(gf *out, gf *in0, gf *in1) {
 
     for (i = 0; i < SYS_T; i++) {
         for (j = 0; j < SYS_T; j++) {
-            prod[i + j] ^= gf_mul(in0[i], in1[j]);
+            prod[i + j] ^= gf_mul_fast(in0[i], in1[j]);
         }
     }
 
@@ -128,7 +168,7 @@ void GF_mul(gf *out, gf *in0, gf *in1) {
     for (i = (SYS_T - 1) * 2; i >= SYS_T; i--) {
         prod[i - SYS_T + 3] ^= prod[i];
         prod[i - SYS_T + 1] ^= prod[i];
-        prod[i - SYS_T + 0] ^= gf_mul(prod[i], (gf) 2);
+        prod[i - SYS_T + 0] ^= gf_mul_fast(prod[i], (gf) 2);
     }
 
     for (i = 0; i < SYS_T; i++) {
@@ -6,9 +6,70 @@
 
 #include <stdint.h>
 
+//#define DISABLE_CUSTOM_INSTRUCTION
+#ifndef DISABLE_CUSTOM_INSTRUCTION
+#include "picorv32_insn.h"
+
+/* One perfect shuffle of a 32x32 matrix seen as a 1024-bit string,
+   rows i and i + 16 are interleaved into rows 2i and 2i + 1. Five of
+   them rotate the (row, column) bit index by five bits, i.e. transpose. */
+static void shuffle_32x32(uint32_t *out, const uint32_t *in) {
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        out[2 * i + 0] = picorv32_zip(picorv32_pack(in[i], in[i + 16]));
+        out[2 * i + 1] = picorv32_zip(picorv32_packu(in[i], in[i + 16]));
+    }
+}
+#endif // DISABLE_CUSTOM_INSTRUCTION
+
+/* input: in, a 32x32 matrix over GF(2) */
+/* output: out, transpose of in, must not overlap in */
+void transpose_32x32(uint32_t *out, const uint32_t *in) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
+    int i, j, s, d;
+
+    uint32_t x, y;
+    uint32_t masks[5][2] = {
+        {0x55555555, 0xAAAAAAAA},
+        {0x33333333, 0xCCCCCCCC},
+        {0x0F0F0F0F, 0xF0F0F0F0},
+        {0x00FF00FF, 0xFF00FF00},
+        {0x0000FFFF, 0xFFFF0000}
+    };
+
+    for (i = 0; i < 32; i++) {
+        out[i] = in[i];
+    }
+
+    for (d = 4; d >= 0; d--) {
+        s = 1 << d;
+
+        for (i = 0; i < 32; i += s * 2) {
+            for (j = i; j < i + s; j++) {
+                x = (out[j] & masks[d][0]) | ((out[j + s] & masks[d][0]) << s);
+                y = ((out[j] & masks[d][1]) >> s) | (out[j + s] & masks[d][1]);
+
+                out[j + 0] = x;
+                out[j + s] = y;
+            }
+        }
+    }
+#else
+    uint32_t t[32];
+
+    shuffle_32x32(out, in);
+    shuffle_32x32(t, out);
+    shuffle_32x32(out, t);
+    shuffle_32x32(t, out);
+    shuffle_32x32(out, t);
+#endif // DISABLE_CUSTOM_INSTRUCTION
+}
+
 /* input: in, a 64x64 matrix over GF(2) */
 /* output: out, transpose of in */
 void transpose_64x64(uint64_t *out, const uint64_t *in) {
+#ifdef DISABLE_CUSTOM_INSTRUCTION
     int i, j, s, d;
 
     uint64_t x, y;
@@ -38,4 +99,25 @@ void transpose_64x64(uint64_t *out, const uint64_t *in) {
             }
         }
     }
+#else
+    /* transpose the four 32x32 blocks and swap the off-diagonal ones */
+    int i;
+    uint32_t a[4][32], b[4][32];
+
+    for (i = 0; i < 32; i++) {
+        a[0][i] = (uint32_t)in[i];
+        a[1][i] = (uint32_t)(in[i] >> 32);
+        a[2][i] = (uint32_t)in[i + 32];
+        a[3][i] = (uint32_t)(in[i + 32] >> 32);
+    }
+
+    for (i = 0; i < 4; i++) {
+        transpose_32x32(b[i], a[i]);
+    }
+
+    for (i = 0; i < 32; i++) {
+        out[i] = ((uint64_t)b[2][i] << 32) | b[0][i];
+        out[i + 32] = ((uint64_t)b[3][i] << 32) | b[1][i];
+    }
+#endif // DISABLE_CUSTOM_INSTRUCTION
 }
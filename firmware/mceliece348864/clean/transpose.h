@@ -7,9 +7,11 @@
 #include "namespace.h"
 
 #define transpose_64x64 CRYPTO_NAMESPACE(transpose_64x64)
+#define transpose_32x32 CRYPTO_NAMESPACE(transpose_32x32)
 
 #include <inttypes.h>
 
 void transpose_64x64(uint64_t *out, const uint64_t *in);
+void transpose_32x32(uint32_t *out, const uint32_t *in);
 
 #endif
@@ -64,6 +64,7 @@ module picorv32 #(
 	parameter [ 0:0] ENABLE_COUNTERS64 = 1,
 	parameter [ 0:0] ENABLE_REGS_16_31 = 1,
 	parameter [ 0:0] ENABLE_REGS_DUALPORT = 1,
+	parameter [ 0:0] ENABLE_REGS_RS3 = 0,
 	parameter [ 0:0] LATCHED_MEM_RDATA = 0,
 	parameter [ 0:0] TWO_STAGE_SHIFT = 1,
 	parameter [ 0:0] BARREL_SHIFTER = 0,
@@ -81,6 +82,27 @@ module picorv32 #(
 	parameter [ 0:0] ENABLE_IRQ_TIMER = 1,
 	parameter [ 0:0] ENABLE_TRACE = 0,
 	parameter [ 0:0] REGS_INIT_ZERO = 0,
+	parameter [ 0:0] ENABLE_KYBER_NTT = 0,
+	parameter [ 0:0] ENABLE_KYBER_MONT = 0,
+	parameter [ 0:0] ENABLE_KYBER_CBD = 0,
+	parameter [ 0:0] ENABLE_REJ_UNIFORM = 0,
+	parameter [ 0:0] ENABLE_KYBER_COMPRESS = 0,
+	parameter [ 0:0] ENABLE_DILITHIUM_MONT = 0,
+	parameter [ 0:0] ENABLE_DILITHIUM_ROUND = 0,
+	parameter [ 0:0] ENABLE_GFMUL12 = 0,
+	parameter [ 0:0] ENABLE_AES32 = 0,
+	parameter [ 0:0] ENABLE_ZBKB = 0,
+	parameter [ 0:0] ENABLE_ZBP = 0,
+	parameter [ 0:0] ENABLE_CLMUL = 0,
+	parameter [ 0:0] ENABLE_FAST_CLMUL = 0,
+	parameter [ 0:0] ENABLE_SIMD16 = 0,
+	parameter [ 0:0] ENABLE_ZKNH = 0,
+	parameter [ 0:0] ENABLE_HWLOOP = 0,
+	parameter [ 0:0] ENABLE_PIPELINE = 0,
+	parameter [ 0:0] ENABLE_BTFN = 0,
+	parameter integer TCM_WORDS = 0,
+	parameter [31:0] TCM_ADDR = 32'h 0400_0000,
+	parameter [31:0] HPM_EVENTS = 32'h 0000_0000,
 	parameter [31:0] MASKED_IRQ = 32'h 0000_0000,
 	parameter [31:0] LATCHED_IRQ = 32'h ffff_ffff,
 	parameter [31:0] PROGADDR_RESET = 32'h 0000_0000,
@@ -111,6 +133,7 @@ module picorv32 #(
 	output reg [31:0] pcpi_insn,
 	output     [31:0] pcpi_rs1,
 	output     [31:0] pcpi_rs2,
+	output     [31:0] pcpi_rs3,
 	input             pcpi_wr,
 	input      [31:0] pcpi_rd,
 	input             pcpi_wait,
@@ -166,14 +189,19 @@ module picorv32 #(
 	localparam integer regfile_size = (ENABLE_REGS_16_31 ? 32 : 16) + 4*ENABLE_IRQ*ENABLE_IRQ_QREGS;
 	localparam integer regindex_bits = (ENABLE_REGS_16_31 ? 5 : 4) + ENABLE_IRQ*ENABLE_IRQ_QREGS;
 
-	localparam WITH_PCPI = ENABLE_PCPI || ENABLE_MUL || ENABLE_FAST_MUL || ENABLE_DIV;
+	localparam WITH_PCPI = ENABLE_PCPI || ENABLE_MUL || ENABLE_FAST_MUL || ENABLE_DIV || ENABLE_KYBER_MONT ||
+			ENABLE_DILITHIUM_MONT || ENABLE_CLMUL || ENABLE_FAST_CLMUL;
+	localparam WITH_PIPELINE = ENABLE_PIPELINE && ENABLE_REGS_DUALPORT && !TWO_CYCLE_ALU && !TWO_CYCLE_COMPARE;
+	localparam WITH_ALU_WAIT = TWO_CYCLE_ALU || TWO_CYCLE_COMPARE || ENABLE_KYBER_NTT || ENABLE_AES32;
+	localparam integer hpm_events = 6;
 
 	localparam [35:0] TRACE_BRANCH = {4'b 0001, 32'b 0};
 	localparam [35:0] TRACE_ADDR   = {4'b 0010, 32'b 0};
 	localparam [35:0] TRACE_IRQ    = {4'b 1000, 32'b 0};
 
 	reg [63:0] count_cycle, count_instr;
-	reg [31:0] reg_pc, reg_next_pc, reg_op1, reg_op2, reg_out;
+	reg [31:0] count_bmiss;
+	reg [31:0] reg_pc, reg_next_pc, reg_op1, reg_op2, reg_op3, reg_out;
 	reg [4:0] reg_sh;
 
 	reg [31:0] next_insn_opcode;
@@ -190,6 +218,7 @@ module picorv32 #(
 
 	assign pcpi_rs1 = reg_op1;
 	assign pcpi_rs2 = reg_op2;
+	assign pcpi_rs3 = ENABLE_REGS_RS3 ? reg_op3 : 0;
 
 	wire [31:0] next_pc;
 
@@ -264,6 +293,21 @@ module picorv32 #(
 	wire        pcpi_div_wait;
 	wire        pcpi_div_ready;
 
+	wire        pcpi_kyber_wr;
+	wire [31:0] pcpi_kyber_rd;
+	wire        pcpi_kyber_wait;
+	wire        pcpi_kyber_ready;
+
+	wire        pcpi_dilithium_wr;
+	wire [31:0] pcpi_dilithium_rd;
+	wire        pcpi_dilithium_wait;
+	wire        pcpi_dilithium_ready;
+
+	wire        pcpi_clmul_wr;
+	wire [31:0] pcpi_clmul_rd;
+	wire        pcpi_clmul_wait;
+	wire        pcpi_clmul_ready;
+
 	reg        pcpi_int_wr;
 	reg [31:0] pcpi_int_rd;
 	reg        pcpi_int_wait;
@@ -322,11 +366,89 @@ module picorv32 #(
 		assign pcpi_div_ready = 0;
 	end endgenerate
 
+	generate if (ENABLE_KYBER_MONT) begin
+		picorv32_pcpi_kyber #(
+			.ENABLE_MAC(ENABLE_REGS_RS3)
+		) pcpi_kyber (
+			.clk       (clk             ),
+			.resetn    (resetn          ),
+			.pcpi_valid(pcpi_valid      ),
+			.pcpi_insn (pcpi_insn       ),
+			.pcpi_rs1  (pcpi_rs1        ),
+			.pcpi_rs2  (pcpi_rs2        ),
+			.pcpi_rs3  (pcpi_rs3        ),
+			.pcpi_wr   (pcpi_kyber_wr   ),
+			.pcpi_rd   (pcpi_kyber_rd   ),
+			.pcpi_wait (pcpi_kyber_wait ),
+			.pcpi_ready(pcpi_kyber_ready)
+		);
+	end else begin
+		assign pcpi_kyber_wr = 0;
+		assign pcpi_kyber_rd = 32'bx;
+		assign pcpi_kyber_wait = 0;
+		assign pcpi_kyber_ready = 0;
+	end endgenerate
+
+	generate if (ENABLE_DILITHIUM_MONT) begin
+		picorv32_pcpi_dilithium pcpi_dilithium (
+			.clk       (clk                 ),
+			.resetn    (resetn              ),
+			.pcpi_valid(pcpi_valid          ),
+			.pcpi_insn (pcpi_insn           ),
+			.pcpi_rs1  (pcpi_rs1            ),
+			.pcpi_rs2  (pcpi_rs2            ),
+			.pcpi_wr   (pcpi_dilithium_wr   ),
+			.pcpi_rd   (pcpi_dilithium_rd   ),
+			.pcpi_wait (pcpi_dilithium_wait ),
+			.pcpi_ready(pcpi_dilithium_ready)
+		);
+	end else begin
+		assign pcpi_dilithium_wr = 0;
+		assign pcpi_dilithium_rd = 32'bx;
+		assign pcpi_dilithium_wait = 0;
+		assign pcpi_dilithium_ready = 0;
+	end endgenerate
+
+	generate if (ENABLE_FAST_CLMUL) begin
+		picorv32_pcpi_fast_clmul pcpi_clmul (
+			.clk       (clk             ),
+			.resetn    (resetn          ),
+			.pcpi_valid(pcpi_valid      ),
+			.pcpi_insn (pcpi_insn       ),
+			.pcpi_rs1  (pcpi_rs1        ),
+			.pcpi_rs2  (pcpi_rs2        ),
+			.pcpi_wr   (pcpi_clmul_wr   ),
+			.pcpi_rd   (pcpi_clmul_rd   ),
+			.pcpi_wait (pcpi_clmul_wait ),
+			.pcpi_ready(pcpi_clmul_ready)
+		);
+	end else if (ENABLE_CLMUL) begin
+		picorv32_pcpi_clmul pcpi_clmul (
+			.clk       (clk             ),
+			.resetn    (resetn          ),
+			.pcpi_valid(pcpi_valid      ),
+			.pcpi_insn (pcpi_insn       ),
+			.pcpi_rs1  (pcpi_rs1        ),
+			.pcpi_rs2  (pcpi_rs2        ),
+			.pcpi_wr   (pcpi_clmul_wr   ),
+			.pcpi_rd   (pcpi_clmul_rd   ),
+			.pcpi_wait (pcpi_clmul_wait ),
+			.pcpi_ready(pcpi_clmul_ready)
+		);
+	end else begin
+		assign pcpi_clmul_wr = 0;
+		assign pcpi_clmul_rd = 32'bx;
+		assign pcpi_clmul_wait = 0;
+		assign pcpi_clmul_ready = 0;
+	end endgenerate
+
 	always @* begin
 		pcpi_int_wr = 0;
 		pcpi_int_rd = 32'bx;
-		pcpi_int_wait  = |{ENABLE_PCPI && pcpi_wait,  (ENABLE_MUL || ENABLE_FAST_MUL) && pcpi_mul_wait,  ENABLE_DIV && pcpi_div_wait};
-		pcpi_int_ready = |{ENABLE_PCPI && pcpi_ready, (ENABLE_MUL || ENABLE_FAST_MUL) && pcpi_mul_ready, ENABLE_DIV && pcpi_div_ready};
+		pcpi_int_wait  = |{ENABLE_PCPI && pcpi_wait,  (ENABLE_MUL || ENABLE_FAST_MUL) && pcpi_mul_wait,  ENABLE_DIV && pcpi_div_wait,
+				ENABLE_KYBER_MONT && pcpi_kyber_wait, ENABLE_DILITHIUM_MONT && pcpi_dilithium_wait, (ENABLE_CLMUL || ENABLE_FAST_CLMUL) && pcpi_clmul_wait};
+		pcpi_int_ready = |{ENABLE_PCPI && pcpi_ready, (ENABLE_MUL || ENABLE_FAST_MUL) && pcpi_mul_ready, ENABLE_DIV && pcpi_div_ready,
+				ENABLE_KYBER_MONT && pcpi_kyber_ready, ENABLE_DILITHIUM_MONT && pcpi_dilithium_ready, (ENABLE_CLMUL || ENABLE_FAST_CLMUL) && pcpi_clmul_ready};
 
 		(* parallel_case *)
 		case (1'b1)
@@ -342,6 +464,18 @@ module picorv32 #(
 				pcpi_int_wr = pcpi_div_wr;
 				pcpi_int_rd = pcpi_div_rd;
 			end
+			ENABLE_KYBER_MONT && pcpi_kyber_ready: begin
+				pcpi_int_wr = pcpi_kyber_wr;
+				pcpi_int_rd = pcpi_kyber_rd;
+			end
+			ENABLE_DILITHIUM_MONT && pcpi_dilithium_ready: begin
+				pcpi_int_wr = pcpi_dilithium_wr;
+				pcpi_int_rd = pcpi_dilithium_rd;
+			end
+			(ENABLE_CLMUL || ENABLE_FAST_CLMUL) && pcpi_clmul_ready: begin
+				pcpi_int_wr = pcpi_clmul_wr;
+				pcpi_int_rd = pcpi_clmul_rd;
+			end
 		endcase
 	end
 
@@ -357,6 +491,13 @@ module picorv32 #(
 	reg mem_do_rdata;
 	reg mem_do_wdata;
 
+	// ENABLE_PIPELINE: pipe_fetch starts the prefetch of the next instruction
+	// in the cycle the current one is launched, and pipe_rinst completes that
+	// prefetch like an instruction fetch while the current instruction is
+	// executed in cpu_state_ld_rs1 (see pipe_exec).
+	wire pipe_fetch, pipe_rinst;
+	wire [31:0] pipe_fetch_pc;
+
 	wire mem_xfer;
 	reg mem_la_secondword, mem_la_firstword_reg, last_mem_valid;
 	wire mem_la_firstword = COMPRESSED_ISA && (mem_do_prefetch || mem_do_rinst) && next_pc[1] && !mem_la_secondword;
@@ -370,16 +511,29 @@ module picorv32 #(
 	wire [31:0] mem_rdata_latched;
 
 	wire mem_la_use_prefetched_high_word = COMPRESSED_ISA && mem_la_firstword && prefetched_high_word && !clear_prefetched_high_word;
-	assign mem_xfer = (mem_valid && mem_ready) || (mem_la_use_prefetched_high_word && mem_do_rinst);
+
+	// Loads and stores to the TCM_ADDR window (TCM_WORDS > 0) are served by the
+	// tightly-coupled memory and never show up on the memory interface. They
+	// complete in the cycle after the look-ahead cycle, like a zero-wait-state
+	// memory, without waiting for mem_ready.
+	reg tcm_sel;
+	wire [31:0] tcm_rdata;
+	wire tcm_la_sel = TCM_WORDS && (reg_op1 & ~(4*TCM_WORDS-1)) == TCM_ADDR;
+	wire tcm_la_read = resetn && !mem_state && mem_do_rdata && tcm_la_sel;
+	wire tcm_la_write = resetn && !mem_state && mem_do_wdata && tcm_la_sel;
+	wire [31:0] mem_rdata_load = TCM_WORDS && tcm_sel ? tcm_rdata : mem_rdata;
+
+	assign mem_xfer = (mem_valid && mem_ready) || (mem_la_use_prefetched_high_word && mem_do_rinst) || (TCM_WORDS && tcm_sel && |mem_state);
 
 	wire mem_busy = |{mem_do_prefetch, mem_do_rinst, mem_do_rdata, mem_do_wdata};
-	wire mem_done = resetn && ((mem_xfer && |mem_state && (mem_do_rinst || mem_do_rdata || mem_do_wdata)) || (&mem_state && mem_do_rinst)) &&
+	wire mem_done = resetn && ((mem_xfer && |mem_state && (mem_do_rinst || pipe_rinst || mem_do_rdata || mem_do_wdata)) || (&mem_state && (mem_do_rinst || pipe_rinst))) &&
 			(!mem_la_firstword || (~&mem_rdata_latched[1:0] && mem_xfer));
 
-	assign mem_la_write = resetn && !mem_state && mem_do_wdata;
-	assign mem_la_read = resetn && ((!mem_la_use_prefetched_high_word && !mem_state && (mem_do_rinst || mem_do_prefetch || mem_do_rdata)) ||
+	assign mem_la_write = resetn && !mem_state && mem_do_wdata && !tcm_la_write;
+	assign mem_la_read = resetn && ((!mem_la_use_prefetched_high_word && !mem_state && (mem_do_rinst || mem_do_prefetch || mem_do_rdata) && !tcm_la_read) || pipe_fetch ||
 			(COMPRESSED_ISA && mem_xfer && (!last_mem_valid ? mem_la_firstword : mem_la_firstword_reg) && !mem_la_secondword && &mem_rdata_latched[1:0]));
-	assign mem_la_addr = (mem_do_prefetch || mem_do_rinst) ? {next_pc[31:2] + mem_la_firstword_xfer, 2'b00} : {reg_op1[31:2], 2'b00};
+	assign mem_la_addr = (mem_do_prefetch || mem_do_rinst) ? {next_pc[31:2] + mem_la_firstword_xfer, 2'b00} :
+			pipe_fetch ? {pipe_fetch_pc[31:2], 2'b00} : {reg_op1[31:2], 2'b00};
 
 	assign mem_rdata_latched_noshuffle = (mem_xfer || LATCHED_MEM_RDATA) ? mem_rdata : mem_rdata_q;
 
@@ -404,24 +558,24 @@ module picorv32 #(
 			0: begin
 				mem_la_wdata = reg_op2;
 				mem_la_wstrb = 4'b1111;
-				mem_rdata_word = mem_rdata;
+				mem_rdata_word = mem_rdata_load;
 			end
 			1: begin
 				mem_la_wdata = {2{reg_op2[15:0]}};
 				mem_la_wstrb = reg_op1[1] ? 4'b1100 : 4'b0011;
 				case (reg_op1[1])
-					1'b0: mem_rdata_word = {16'b0, mem_rdata[15: 0]};
-					1'b1: mem_rdata_word = {16'b0, mem_rdata[31:16]};
+					1'b0: mem_rdata_word = {16'b0, mem_rdata_load[15: 0]};
+					1'b1: mem_rdata_word = {16'b0, mem_rdata_load[31:16]};
 				endcase
 			end
 			2: begin
 				mem_la_wdata = {4{reg_op2[7:0]}};
 				mem_la_wstrb = 4'b0001 << reg_op1[1:0];
 				case (reg_op1[1:0])
-					2'b00: mem_rdata_word = {24'b0, mem_rdata[ 7: 0]};
-					2'b01: mem_rdata_word = {24'b0, mem_rdata[15: 8]};
-					2'b10: mem_rdata_word = {24'b0, mem_rdata[23:16]};
-					2'b11: mem_rdata_word = {24'b0, mem_rdata[31:24]};
+					2'b00: mem_rdata_word = {24'b0, mem_rdata_load[ 7: 0]};
+					2'b01: mem_rdata_word = {24'b0, mem_rdata_load[15: 8]};
+					2'b10: mem_rdata_word = {24'b0, mem_rdata_load[23:16]};
+					2'b11: mem_rdata_word = {24'b0, mem_rdata_load[31:24]};
 				endcase
 			end
 		endcase
@@ -558,14 +712,16 @@ module picorv32 #(
 				`assert(!(mem_do_prefetch || mem_do_rinst || mem_do_rdata));
 
 			if (mem_state == 2 || mem_state == 3)
-				`assert(mem_valid || mem_do_prefetch);
+				`assert(mem_valid || mem_do_prefetch || tcm_sel);
 		end
 	end
 
 	always @(posedge clk) begin
 		if (!resetn || trap) begin
-			if (!resetn)
+			if (!resetn) begin
 				mem_state <= 0;
+				tcm_sel <= 0;
+			end
 			if (!resetn || mem_ready)
 				mem_valid <= 0;
 			mem_la_secondword <= 0;
@@ -580,22 +736,24 @@ module picorv32 #(
 			end
 			case (mem_state)
 				0: begin
-					if (mem_do_prefetch || mem_do_rinst || mem_do_rdata) begin
-						mem_valid <= !mem_la_use_prefetched_high_word;
-						mem_instr <= mem_do_prefetch || mem_do_rinst;
+					if (mem_do_prefetch || mem_do_rinst || mem_do_rdata || pipe_fetch) begin
+						mem_valid <= !mem_la_use_prefetched_high_word && !tcm_la_read;
+						mem_instr <= mem_do_prefetch || mem_do_rinst || pipe_fetch;
 						mem_wstrb <= 0;
 						mem_state <= 1;
+						tcm_sel <= tcm_la_read;
 					end
 					if (mem_do_wdata) begin
-						mem_valid <= 1;
+						mem_valid <= !tcm_la_write;
 						mem_instr <= 0;
 						mem_state <= 2;
+						tcm_sel <= tcm_la_write;
 					end
 				end
 				1: begin
 					`assert(mem_wstrb == 0);
 					`assert(mem_do_prefetch || mem_do_rinst || mem_do_rdata);
-					`assert(mem_valid == !mem_la_use_prefetched_high_word);
+					`assert(mem_valid == !(mem_la_use_prefetched_high_word || tcm_sel));
 					`assert(mem_instr == (mem_do_prefetch || mem_do_rinst));
 					if (mem_xfer) begin
 						if (COMPRESSED_ISA && mem_la_read) begin
@@ -614,12 +772,12 @@ module picorv32 #(
 									prefetched_high_word <= 0;
 								end
 							end
-							mem_state <= mem_do_rinst || mem_do_rdata ? 0 : 3;
+							mem_state <= mem_do_rinst || pipe_rinst || mem_do_rdata ? 0 : 3;
 						end
 					end
 				end
 				2: begin
-					`assert(mem_wstrb != 0);
+					`assert(mem_wstrb != 0 || tcm_sel);
 					`assert(mem_do_wdata);
 					if (mem_xfer) begin
 						mem_valid <= 0;
@@ -629,7 +787,7 @@ module picorv32 #(
 				3: begin
 					`assert(mem_wstrb == 0);
 					`assert(mem_do_prefetch);
-					if (mem_do_rinst) begin
+					if (mem_do_rinst || pipe_rinst) begin
 						mem_state <= 0;
 					end
 				end
@@ -640,6 +798,29 @@ module picorv32 #(
 			prefetched_high_word <= 0;
 	end
 
+	generate if (TCM_WORDS) begin:tcm
+		localparam integer INDEX_BITS = $clog2(TCM_WORDS);
+
+		reg [31:0] tcm_mem [0:TCM_WORDS-1];
+		reg [31:0] tcm_rdata_q;
+		wire [INDEX_BITS-1:0] tcm_index = reg_op1[INDEX_BITS+1:2];
+
+		always @(posedge clk) begin
+			if (tcm_la_read)
+				tcm_rdata_q <= tcm_mem[tcm_index];
+			if (tcm_la_write) begin
+				if (mem_la_wstrb[0]) tcm_mem[tcm_index][ 7: 0] <= mem_la_wdata[ 7: 0];
+				if (mem_la_wstrb[1]) tcm_mem[tcm_index][15: 8] <= mem_la_wdata[15: 8];
+				if (mem_la_wstrb[2]) tcm_mem[tcm_index][23:16] <= mem_la_wdata[23:16];
+				if (mem_la_wstrb[3]) tcm_mem[tcm_index][31:24] <= mem_la_wdata[31:24];
+			end
+		end
+
+		assign tcm_rdata = tcm_rdata_q;
+	end else begin
+		assign tcm_rdata = 32'bx;
+	end endgenerate
+
 
 	// Instruction Decoder
 
@@ -647,18 +828,30 @@ module picorv32 #(
 	reg instr_beq, instr_bne, instr_blt, instr_bge, instr_bltu, instr_bgeu;
 	reg instr_lb, instr_lh, instr_lw, instr_lbu, instr_lhu, instr_sb, instr_sh, instr_sw;
 	reg instr_addi, instr_slti, instr_sltiu, instr_xori, instr_ori, instr_andi, instr_slli, instr_srli, instr_srai;
-	reg instr_add, instr_sub, instr_sll, instr_slt, instr_sltu, instr_xor, instr_srl, instr_sra, instr_or, instr_and, instr_aes128, instr_kyber;
-	reg instr_rdcycle, instr_rdcycleh, instr_rdinstr, instr_rdinstrh, instr_ecall_ebreak, instr_fence;
+	reg instr_add, instr_sub, instr_sll, instr_slt, instr_sltu, instr_xor, instr_srl, instr_sra, instr_or, instr_and;
+	reg instr_kyber_ct, instr_kyber_gs, instr_kyber_cbd2, instr_kyber_cbd3, instr_gfmul12;
+	reg instr_kyber_rej, instr_dilithium_rej, instr_kyber_compress, instr_kyber_decompress;
+	reg instr_dilithium_decompose, instr_dilithium_power2round, instr_dilithium_make_hint, instr_dilithium_use_hint;
+	reg instr_aes32esi, instr_aes32esmi, instr_aes32dsi, instr_aes32dsmi;
+	reg instr_ror, instr_rol, instr_rori, instr_andn, instr_orn, instr_xnor;
+	reg instr_pack, instr_packh, instr_rev8, instr_brev8, instr_zip, instr_unzip;
+	reg instr_grev, instr_grevi, instr_shfl, instr_shfli, instr_unshfl, instr_unshfli, instr_packu;
+	reg instr_add16, instr_sub16, instr_kadd16, instr_ksub16, instr_smbb16, instr_smtt16, instr_pkbb16, instr_pktt16;
+	reg instr_sha256sig0, instr_sha256sig1, instr_sha256sum0, instr_sha256sum1;
+	reg instr_sha512sig0l, instr_sha512sig0h, instr_sha512sig1l, instr_sha512sig1h, instr_sha512sum0r, instr_sha512sum1r;
+	reg instr_rdcycle, instr_rdcycleh, instr_rdinstr, instr_rdinstrh, instr_rdbmiss, instr_rdhpm, instr_ecall_ebreak, instr_fence;
 	reg instr_getq, instr_setq, instr_retirq, instr_maskirq, instr_waitirq, instr_timer;
+	reg instr_lp_setup;
 	wire instr_trap;
 
-	reg [regindex_bits-1:0] decoded_rd, decoded_rs1, decoded_rs2;
+	reg [regindex_bits-1:0] decoded_rd, decoded_rs1, decoded_rs2, decoded_rs3;
 	reg [31:0] decoded_imm, decoded_imm_j;
 	reg decoder_trigger;
 	reg decoder_trigger_q;
 	reg decoder_pseudo_trigger;
 	reg decoder_pseudo_trigger_q;
 	reg compressed_instr;
+	reg branch_bwd;
 
 	reg is_lui_auipc_jal;
 	reg is_lb_lh_lw_lbu_lhu;
@@ -667,8 +860,18 @@ module picorv32 #(
 	reg is_sb_sh_sw;
 	reg is_sll_srl_sra;
 	reg is_lui_auipc_jal_jalr_addi_add_sub;
-	reg is_aes128;
-	reg is_kyber;
+	reg is_kyber_ct_gs;
+	reg is_kyber_cbd;
+	reg is_dilithium_round;
+	reg is_aes32;
+	reg [1:0] aes32_bs;
+	reg is_zbkb;
+	reg is_zbkb_imm;
+	reg is_zbp;
+	reg is_zbp_imm;
+	reg is_simd16;
+	reg is_zknh;
+	reg is_zknh_imm;
 	reg is_slti_blt_slt;
 	reg is_sltiu_bltu_sltu;
 	reg is_beq_bne_blt_bge_bltu_bgeu;
@@ -681,9 +884,20 @@ module picorv32 #(
 			instr_beq, instr_bne, instr_blt, instr_bge, instr_bltu, instr_bgeu,
 			instr_lb, instr_lh, instr_lw, instr_lbu, instr_lhu, instr_sb, instr_sh, instr_sw,
 			instr_addi, instr_slti, instr_sltiu, instr_xori, instr_ori, instr_andi, instr_slli, instr_srli, instr_srai,
-			instr_add, instr_sub, instr_sll, instr_slt, instr_sltu, instr_xor, instr_srl, instr_sra, instr_or, instr_and, instr_aes128, instr_kyber,
-			instr_rdcycle, instr_rdcycleh, instr_rdinstr, instr_rdinstrh, instr_fence,
-			instr_getq, instr_setq, instr_retirq, instr_maskirq, instr_waitirq, instr_timer};
+			instr_add, instr_sub, instr_sll, instr_slt, instr_sltu, instr_xor, instr_srl, instr_sra, instr_or, instr_and,
+			instr_kyber_ct, instr_kyber_gs, instr_kyber_cbd2, instr_kyber_cbd3, instr_gfmul12,
+			instr_kyber_rej, instr_dilithium_rej, instr_kyber_compress, instr_kyber_decompress,
+			instr_dilithium_decompose, instr_dilithium_power2round, instr_dilithium_make_hint, instr_dilithium_use_hint,
+			instr_aes32esi, instr_aes32esmi, instr_aes32dsi, instr_aes32dsmi,
+			instr_ror, instr_rol, instr_rori, instr_andn, instr_orn, instr_xnor,
+			instr_pack, instr_packh, instr_rev8, instr_brev8, instr_zip, instr_unzip,
+			instr_grev, instr_grevi, instr_shfl, instr_shfli, instr_unshfl, instr_unshfli, instr_packu,
+			instr_add16, instr_sub16, instr_kadd16, instr_ksub16, instr_smbb16, instr_smtt16, instr_pkbb16, instr_pktt16,
+			instr_sha256sig0, instr_sha256sig1, instr_sha256sum0, instr_sha256sum1,
+			instr_sha512sig0l, instr_sha512sig0h, instr_sha512sig1l, instr_sha512sig1h, instr_sha512sum0r, instr_sha512sum1r,
+			instr_rdcycle, instr_rdcycleh, instr_rdinstr, instr_rdinstrh, instr_rdbmiss, instr_rdhpm, instr_fence,
+			instr_getq, instr_setq, instr_retirq, instr_maskirq, instr_waitirq, instr_timer,
+			instr_lp_setup};
 
 	wire is_rdcycle_rdcycleh_rdinstr_rdinstrh;
 	assign is_rdcycle_rdcycleh_rdinstr_rdinstrh = |{instr_rdcycle, instr_rdcycleh, instr_rdinstr, instr_rdinstrh};
@@ -743,13 +957,67 @@ module picorv32 #(
 		if (instr_sra)      new_ascii_instr = "sra";
 		if (instr_or)       new_ascii_instr = "or";
 		if (instr_and)      new_ascii_instr = "and";
-		if (instr_aes128)   new_ascii_instr = "aes128";
-		if (instr_kyber)   new_ascii_instr = "kyber";
+		if (instr_kyber_ct) new_ascii_instr = "kyber_ct";
+		if (instr_kyber_gs) new_ascii_instr = "kyber_gs";
+		if (instr_kyber_cbd2) new_ascii_instr = "kyber_cbd2";
+		if (instr_kyber_cbd3) new_ascii_instr = "kyber_cbd3";
+		if (instr_kyber_rej) new_ascii_instr = "kyber_rej";
+		if (instr_dilithium_rej) new_ascii_instr = "dilithium_rej";
+		if (instr_kyber_compress) new_ascii_instr = "kyber_compress";
+		if (instr_kyber_decompress) new_ascii_instr = "kyber_decompress";
+		if (instr_dilithium_decompose) new_ascii_instr = "dilithium_decompose";
+		if (instr_dilithium_power2round) new_ascii_instr = "dilithium_power2round";
+		if (instr_dilithium_make_hint) new_ascii_instr = "dilithium_make_hint";
+		if (instr_dilithium_use_hint) new_ascii_instr = "dilithium_use_hint";
+		if (instr_gfmul12)  new_ascii_instr = "gfmul12";
+		if (instr_aes32esi) new_ascii_instr = "aes32esi";
+		if (instr_aes32esmi) new_ascii_instr = "aes32esmi";
+		if (instr_aes32dsi) new_ascii_instr = "aes32dsi";
+		if (instr_aes32dsmi) new_ascii_instr = "aes32dsmi";
+		if (instr_ror)      new_ascii_instr = "ror";
+		if (instr_rol)      new_ascii_instr = "rol";
+		if (instr_rori)     new_ascii_instr = "rori";
+		if (instr_andn)     new_ascii_instr = "andn";
+		if (instr_orn)      new_ascii_instr = "orn";
+		if (instr_xnor)     new_ascii_instr = "xnor";
+		if (instr_pack)     new_ascii_instr = "pack";
+		if (instr_packh)    new_ascii_instr = "packh";
+		if (instr_rev8)     new_ascii_instr = "rev8";
+		if (instr_brev8)    new_ascii_instr = "brev8";
+		if (instr_zip)      new_ascii_instr = "zip";
+		if (instr_unzip)    new_ascii_instr = "unzip";
+		if (instr_grev)     new_ascii_instr = "grev";
+		if (instr_grevi)    new_ascii_instr = "grevi";
+		if (instr_shfl)     new_ascii_instr = "shfl";
+		if (instr_shfli)    new_ascii_instr = "shfli";
+		if (instr_unshfl)   new_ascii_instr = "unshfl";
+		if (instr_unshfli)  new_ascii_instr = "unshfli";
+		if (instr_packu)    new_ascii_instr = "packu";
+		if (instr_add16)    new_ascii_instr = "add16";
+		if (instr_sub16)    new_ascii_instr = "sub16";
+		if (instr_kadd16)   new_ascii_instr = "kadd16";
+		if (instr_ksub16)   new_ascii_instr = "ksub16";
+		if (instr_smbb16)   new_ascii_instr = "smbb16";
+		if (instr_smtt16)   new_ascii_instr = "smtt16";
+		if (instr_pkbb16)   new_ascii_instr = "pkbb16";
+		if (instr_pktt16)   new_ascii_instr = "pktt16";
+		if (instr_sha256sig0)  new_ascii_instr = "sha256sig0";
+		if (instr_sha256sig1)  new_ascii_instr = "sha256sig1";
+		if (instr_sha256sum0)  new_ascii_instr = "sha256sum0";
+		if (instr_sha256sum1)  new_ascii_instr = "sha256sum1";
+		if (instr_sha512sig0l) new_ascii_instr = "sha512sig0l";
+		if (instr_sha512sig0h) new_ascii_instr = "sha512sig0h";
+		if (instr_sha512sig1l) new_ascii_instr = "sha512sig1l";
+		if (instr_sha512sig1h) new_ascii_instr = "sha512sig1h";
+		if (instr_sha512sum0r) new_ascii_instr = "sha512sum0r";
+		if (instr_sha512sum1r) new_ascii_instr = "sha512sum1r";
 
 		if (instr_rdcycle)  new_ascii_instr = "rdcycle";
 		if (instr_rdcycleh) new_ascii_instr = "rdcycleh";
 		if (instr_rdinstr)  new_ascii_instr = "rdinstr";
 		if (instr_rdinstrh) new_ascii_instr = "rdinstrh";
+		if (instr_rdbmiss)  new_ascii_instr = "rdbmiss";
+		if (instr_rdhpm)    new_ascii_instr = "rdhpm";
 		if (instr_fence)    new_ascii_instr = "fence";
 
 		if (instr_getq)     new_ascii_instr = "getq";
@@ -758,6 +1026,8 @@ module picorv32 #(
 		if (instr_maskirq)  new_ascii_instr = "maskirq";
 		if (instr_waitirq)  new_ascii_instr = "waitirq";
 		if (instr_timer)    new_ascii_instr = "timer";
+
+		if (instr_lp_setup) new_ascii_instr = "lp.setup";
 	end
 
 	reg [63:0] q_ascii_instr;
@@ -861,14 +1131,22 @@ module picorv32 #(
 	always @(posedge clk) begin
 		is_lui_auipc_jal <= |{instr_lui, instr_auipc, instr_jal};
 		is_lui_auipc_jal_jalr_addi_add_sub <= |{instr_lui, instr_auipc, instr_jal, instr_jalr, instr_addi, instr_add, instr_sub};
-		is_aes128 <= |{instr_aes128};
-		is_kyber <= |{instr_kyber};
+		is_kyber_ct_gs <= |{instr_kyber_ct, instr_kyber_gs};
+		is_kyber_cbd <= |{instr_kyber_cbd2, instr_kyber_cbd3};
+		is_dilithium_round <= |{instr_dilithium_decompose, instr_dilithium_power2round, instr_dilithium_make_hint, instr_dilithium_use_hint};
+		is_aes32 <= |{instr_aes32esi, instr_aes32esmi, instr_aes32dsi, instr_aes32dsmi};
+		is_zbkb <= |{instr_ror, instr_rol, instr_rori, instr_andn, instr_orn, instr_xnor,
+				instr_pack, instr_packh, instr_rev8, instr_brev8, instr_zip, instr_unzip};
+		is_zbp <= |{instr_grev, instr_grevi, instr_shfl, instr_shfli, instr_unshfl, instr_unshfli, instr_packu};
+		is_simd16 <= |{instr_add16, instr_sub16, instr_kadd16, instr_ksub16, instr_smbb16, instr_smtt16, instr_pkbb16, instr_pktt16};
+		is_zknh <= |{instr_sha256sig0, instr_sha256sig1, instr_sha256sum0, instr_sha256sum1,
+				instr_sha512sig0l, instr_sha512sig0h, instr_sha512sig1l, instr_sha512sig1h, instr_sha512sum0r, instr_sha512sum1r};
 		is_slti_blt_slt <= |{instr_slti, instr_blt, instr_slt};
 		is_sltiu_bltu_sltu <= |{instr_sltiu, instr_bltu, instr_sltu};
 		is_lbu_lhu_lw <= |{instr_lbu, instr_lhu, instr_lw};
 		is_compare <= |{is_beq_bne_blt_bge_bltu_bgeu, instr_slti, instr_slt, instr_sltiu, instr_sltu};
 
-		if (mem_do_rinst && mem_done) begin
+		if ((mem_do_rinst || pipe_rinst) && mem_done) begin
 			instr_lui     <= mem_rdata_latched[6:0] == 7'b0110111;
 			instr_auipc   <= mem_rdata_latched[6:0] == 7'b0010111;
 			instr_jal     <= mem_rdata_latched[6:0] == 7'b1101111;
@@ -877,6 +1155,7 @@ module picorv32 #(
 			instr_waitirq <= mem_rdata_latched[6:0] == 7'b0001011 && mem_rdata_latched[31:25] == 7'b0000100 && ENABLE_IRQ;
 
 			is_beq_bne_blt_bge_bltu_bgeu <= mem_rdata_latched[6:0] == 7'b1100011;
+			branch_bwd                   <= mem_rdata_latched[31];
 			is_lb_lh_lw_lbu_lhu          <= mem_rdata_latched[6:0] == 7'b0000011;
 			is_sb_sh_sw                  <= mem_rdata_latched[6:0] == 7'b0100011;
 			is_alu_reg_imm               <= mem_rdata_latched[6:0] == 7'b0010011;
@@ -887,6 +1166,7 @@ module picorv32 #(
 			decoded_rd <= mem_rdata_latched[11:7];
 			decoded_rs1 <= mem_rdata_latched[19:15];
 			decoded_rs2 <= mem_rdata_latched[24:20];
+			decoded_rs3 <= mem_rdata_latched[31:27];
 
 			if (mem_rdata_latched[6:0] == 7'b0001011 && mem_rdata_latched[31:25] == 7'b0000000 && ENABLE_IRQ && ENABLE_IRQ_QREGS)
 				decoded_rs1[regindex_bits-1] <= 1; // instr_getq
@@ -900,6 +1180,7 @@ module picorv32 #(
 				decoded_rd <= 0;
 				decoded_rs1 <= 0;
 				decoded_rs2 <= 0;
+				decoded_rs3 <= 0;
 
 				{ decoded_imm_j[31:11], decoded_imm_j[4], decoded_imm_j[9:8], decoded_imm_j[10], decoded_imm_j[6],
 				  decoded_imm_j[7], decoded_imm_j[3:1], decoded_imm_j[5], decoded_imm_j[0] } <= $signed({mem_rdata_latched[12:2], 1'b0});
@@ -977,11 +1258,13 @@ module picorv32 #(
 							end
 							3'b110: begin // C.BEQZ
 								is_beq_bne_blt_bge_bltu_bgeu <= 1;
+								branch_bwd <= mem_rdata_latched[12];
 								decoded_rs1 <= 8 + mem_rdata_latched[9:7];
 								decoded_rs2 <= 0;
 							end
 							3'b111: begin // C.BNEZ
 								is_beq_bne_blt_bge_bltu_bgeu <= 1;
+								branch_bwd <= mem_rdata_latched[12];
 								decoded_rs1 <= 8 + mem_rdata_latched[9:7];
 								decoded_rs2 <= 0;
 							end
@@ -1070,18 +1353,78 @@ module picorv32 #(
 			instr_srli  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000000;
 			instr_srai  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0100000;
 
-			instr_add   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_sub   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0100000;
-			instr_sll   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_slt   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b010 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_sltu  <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b011 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_xor   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b100 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_srl   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_sra   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0100000;
-			instr_or    <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b110 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_and   <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b111 && mem_rdata_q[31:25] == 7'b0000000;
-			instr_aes128<= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0000001;
-			instr_kyber <= is_alu_reg_reg && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000010;
+			// is_alu_reg_reg is also set for custom-1 (0101011), which must not alias the
+			// base instructions. A compressed instruction never has that opcode in mem_rdata_q.
+			instr_add   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_sub   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0100000;
+			instr_sll   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_slt   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b010 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_sltu  <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b011 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_xor   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b100 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_srl   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_sra   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0100000;
+			instr_or    <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b110 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_and   <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && mem_rdata_q[14:12] == 3'b111 && mem_rdata_q[31:25] == 7'b0000000;
+			instr_kyber_ct <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b010 && mem_rdata_q[31:25] == 7'b0000010 && ENABLE_KYBER_NTT;
+			instr_kyber_gs <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b011 && mem_rdata_q[31:25] == 7'b0000010 && ENABLE_KYBER_NTT;
+			instr_kyber_cbd2 <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000010 && ENABLE_KYBER_CBD;
+			instr_kyber_cbd3 <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b110 && mem_rdata_q[31:25] == 7'b0000010 && ENABLE_KYBER_CBD;
+			instr_kyber_rej <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b111 && mem_rdata_q[31:25] == 7'b0000010 && ENABLE_REJ_UNIFORM;
+			instr_dilithium_rej <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000011 && ENABLE_REJ_UNIFORM;
+			instr_kyber_compress <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0000110 && ENABLE_KYBER_COMPRESS;
+			instr_kyber_decompress <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000110 && ENABLE_KYBER_COMPRESS;
+			instr_dilithium_decompose <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b010 && mem_rdata_q[31:25] == 7'b0000011 && ENABLE_DILITHIUM_ROUND;
+			instr_dilithium_power2round <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b011 && mem_rdata_q[31:25] == 7'b0000011 && ENABLE_DILITHIUM_ROUND;
+			instr_dilithium_make_hint <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b100 && mem_rdata_q[31:25] == 7'b0000011 && ENABLE_DILITHIUM_ROUND;
+			instr_dilithium_use_hint <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000011 && ENABLE_DILITHIUM_ROUND;
+			instr_gfmul12  <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0101011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0000100 && ENABLE_GFMUL12;
+
+			instr_aes32esi  <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[29:25] == 5'b10001 && ENABLE_AES32;
+			instr_aes32esmi <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[29:25] == 5'b10011 && ENABLE_AES32;
+			instr_aes32dsi  <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[29:25] == 5'b10101 && ENABLE_AES32;
+			instr_aes32dsmi <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[29:25] == 5'b10111 && ENABLE_AES32;
+			aes32_bs <= mem_rdata_q[31:30];
+
+			instr_ror   <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0110000 && ENABLE_ZBKB;
+			instr_rol   <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0110000 && ENABLE_ZBKB;
+			instr_andn  <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b111 && mem_rdata_q[31:25] == 7'b0100000 && ENABLE_ZBKB;
+			instr_orn   <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b110 && mem_rdata_q[31:25] == 7'b0100000 && ENABLE_ZBKB;
+			instr_xnor  <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b100 && mem_rdata_q[31:25] == 7'b0100000 && ENABLE_ZBKB;
+			instr_pack  <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b100 && mem_rdata_q[31:25] == 7'b0000100 && (ENABLE_ZBKB || ENABLE_ZBP);
+			instr_packh <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b111 && mem_rdata_q[31:25] == 7'b0000100 && ENABLE_ZBKB;
+			instr_rori  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0110000 && ENABLE_ZBKB;
+			instr_rev8  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:20] == 12'b011010011000 && ENABLE_ZBKB && !ENABLE_ZBP;
+			instr_brev8 <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:20] == 12'b011010000111 && ENABLE_ZBKB && !ENABLE_ZBP;
+			instr_zip   <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:20] == 12'b000010001111 && ENABLE_ZBKB && !ENABLE_ZBP;
+			instr_unzip <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:20] == 12'b000010001111 && ENABLE_ZBKB && !ENABLE_ZBP;
+
+			instr_grev    <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0110100 && ENABLE_ZBP;
+			instr_shfl    <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000100 && ENABLE_ZBP;
+			instr_unshfl  <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000100 && ENABLE_ZBP;
+			instr_packu   <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b100 && mem_rdata_q[31:25] == 7'b0100100 && ENABLE_ZBP;
+			instr_grevi   <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0110100 && ENABLE_ZBP;
+			instr_shfli   <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:24] == 8'b00001000 && ENABLE_ZBP;
+			instr_unshfli <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:24] == 8'b00001000 && ENABLE_ZBP;
+
+			instr_add16  <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0100000 && ENABLE_SIMD16;
+			instr_sub16  <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0100001 && ENABLE_SIMD16;
+			instr_kadd16 <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0001000 && ENABLE_SIMD16;
+			instr_ksub16 <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0001001 && ENABLE_SIMD16;
+			instr_smbb16 <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000100 && ENABLE_SIMD16;
+			instr_smtt16 <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0010100 && ENABLE_SIMD16;
+			instr_pkbb16 <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000111 && ENABLE_SIMD16;
+			instr_pktt16 <= mem_rdata_q[6:0] == 7'b1110111 && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0010111 && ENABLE_SIMD16;
+
+			instr_sha256sum0  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:20] == 12'b000100000000 && ENABLE_ZKNH;
+			instr_sha256sum1  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:20] == 12'b000100000001 && ENABLE_ZKNH;
+			instr_sha256sig0  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:20] == 12'b000100000010 && ENABLE_ZKNH;
+			instr_sha256sig1  <= is_alu_reg_imm && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:20] == 12'b000100000011 && ENABLE_ZKNH;
+			instr_sha512sum0r <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0101000 && ENABLE_ZKNH;
+			instr_sha512sum1r <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0101001 && ENABLE_ZKNH;
+			instr_sha512sig0l <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0101010 && ENABLE_ZKNH;
+			instr_sha512sig1l <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0101011 && ENABLE_ZKNH;
+			instr_sha512sig0h <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0101110 && ENABLE_ZKNH;
+			instr_sha512sig1h <= is_alu_reg_reg && mem_rdata_q[6:0] == 7'b0110011 && mem_rdata_q[14:12] == 3'b000 && mem_rdata_q[31:25] == 7'b0101111 && ENABLE_ZKNH;
 
 			instr_rdcycle  <= ((mem_rdata_q[6:0] == 7'b1110011 && mem_rdata_q[31:12] == 'b11000000000000000010) ||
 			                   (mem_rdata_q[6:0] == 7'b1110011 && mem_rdata_q[31:12] == 'b11000000000100000010)) && ENABLE_COUNTERS;
@@ -1089,6 +1432,9 @@ module picorv32 #(
 			                   (mem_rdata_q[6:0] == 7'b1110011 && mem_rdata_q[31:12] == 'b11001000000100000010)) && ENABLE_COUNTERS && ENABLE_COUNTERS64;
 			instr_rdinstr  <=  (mem_rdata_q[6:0] == 7'b1110011 && mem_rdata_q[31:12] == 'b11000000001000000010) && ENABLE_COUNTERS;
 			instr_rdinstrh <=  (mem_rdata_q[6:0] == 7'b1110011 && mem_rdata_q[31:12] == 'b11001000001000000010) && ENABLE_COUNTERS && ENABLE_COUNTERS64;
+			instr_rdbmiss  <=  (mem_rdata_q[6:0] == 7'b1110011 && mem_rdata_q[31:12] == 'b11000000001100000010) && ENABLE_COUNTERS && ENABLE_BTFN;
+			instr_rdhpm    <=  (mem_rdata_q[6:0] == 7'b1110011 && mem_rdata_q[31:25] == 7'b1100000 && mem_rdata_q[19:12] == 8'b00000010) &&
+			                   mem_rdata_q[24:20] >= 4 && mem_rdata_q[24:20] < 4 + hpm_events && |(HPM_EVENTS >> (mem_rdata_q[24:20] - 4) & 1);
 
 			instr_ecall_ebreak <= ((mem_rdata_q[6:0] == 7'b1110011 && !mem_rdata_q[31:21] && !mem_rdata_q[19:7]) ||
 					(COMPRESSED_ISA && mem_rdata_q[15:0] == 16'h9002));
@@ -1099,6 +1445,8 @@ module picorv32 #(
 			instr_maskirq <= mem_rdata_q[6:0] == 7'b0001011 && mem_rdata_q[31:25] == 7'b0000011 && ENABLE_IRQ;
 			instr_timer   <= mem_rdata_q[6:0] == 7'b0001011 && mem_rdata_q[31:25] == 7'b0000101 && ENABLE_IRQ && ENABLE_IRQ_TIMER;
 
+			instr_lp_setup <= mem_rdata_q[6:0] == 7'b1111011 && mem_rdata_q[14:12] == 3'b100 && mem_rdata_q[11:7] == 5'b00000 && ENABLE_HWLOOP;
+
 			is_slli_srli_srai <= is_alu_reg_imm && |{
 				mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000000,
 				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000000,
@@ -1114,15 +1462,37 @@ module picorv32 #(
 				mem_rdata_q[14:12] == 3'b111
 			};
 
-			is_sll_srl_sra <= is_alu_reg_reg && |{
+			is_zbkb_imm <= is_alu_reg_imm && ENABLE_ZBKB && |{
+				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0110000,
+				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:20] == 12'b011010011000,
+				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:20] == 12'b011010000111,
+				mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:20] == 12'b000010001111,
+				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:20] == 12'b000010001111
+			};
+
+			is_zbp_imm <= is_alu_reg_imm && ENABLE_ZBP && |{
+				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0110100,
+				mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:24] == 8'b00001000,
+				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:24] == 8'b00001000
+			};
+
+			is_zknh_imm <= is_alu_reg_imm && ENABLE_ZKNH && mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:22] == 10'b0001000000;
+
+			is_sll_srl_sra <= is_alu_reg_reg && mem_rdata_q[6:0] != 7'b0101011 && |{
 				mem_rdata_q[14:12] == 3'b001 && mem_rdata_q[31:25] == 7'b0000000,
 				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0000000,
 				mem_rdata_q[14:12] == 3'b101 && mem_rdata_q[31:25] == 7'b0100000
 			};
 
 			is_lui_auipc_jal_jalr_addi_add_sub <= 0;
-			is_aes128 <= 0;
-			is_kyber<= 0;
+			is_kyber_ct_gs <= 0;
+			is_kyber_cbd <= 0;
+			is_dilithium_round <= 0;
+			is_aes32 <= 0;
+			is_zbkb <= 0;
+			is_zbp <= 0;
+			is_simd16 <= 0;
+			is_zknh <= 0;
 			is_compare <= 0;
 
 			(* parallel_case *)
@@ -1137,6 +1507,8 @@ module picorv32 #(
 					decoded_imm <= $signed({mem_rdata_q[31], mem_rdata_q[7], mem_rdata_q[30:25], mem_rdata_q[11:8], 1'b0});
 				is_sb_sh_sw:
 					decoded_imm <= $signed({mem_rdata_q[31:25], mem_rdata_q[11:7]});
+				ENABLE_HWLOOP && mem_rdata_q[6:0] == 7'b1111011:
+					decoded_imm <= mem_rdata_q[31:20] << 1;
 				default:
 					decoded_imm <= 1'bx;
 			endcase
@@ -1170,8 +1542,61 @@ module picorv32 #(
 			instr_sra   <= 0;
 			instr_or    <= 0;
 			instr_and   <= 0;
-			instr_aes128<= 0;
-			instr_kyber <= 0;
+			instr_kyber_ct <= 0;
+			instr_kyber_gs <= 0;
+			instr_kyber_cbd2 <= 0;
+			instr_kyber_cbd3 <= 0;
+			instr_kyber_rej <= 0;
+			instr_dilithium_rej <= 0;
+			instr_kyber_compress <= 0;
+			instr_kyber_decompress <= 0;
+			instr_dilithium_decompose <= 0;
+			instr_dilithium_power2round <= 0;
+			instr_dilithium_make_hint <= 0;
+			instr_dilithium_use_hint <= 0;
+			instr_gfmul12 <= 0;
+			instr_aes32esi  <= 0;
+			instr_aes32esmi <= 0;
+			instr_aes32dsi  <= 0;
+			instr_aes32dsmi <= 0;
+			instr_ror   <= 0;
+			instr_rol   <= 0;
+			instr_rori  <= 0;
+			instr_andn  <= 0;
+			instr_orn   <= 0;
+			instr_xnor  <= 0;
+			instr_pack  <= 0;
+			instr_packh <= 0;
+			instr_rev8  <= 0;
+			instr_brev8 <= 0;
+			instr_zip   <= 0;
+			instr_unzip <= 0;
+			instr_grev    <= 0;
+			instr_grevi   <= 0;
+			instr_shfl    <= 0;
+			instr_shfli   <= 0;
+			instr_unshfl  <= 0;
+			instr_unshfli <= 0;
+			instr_packu   <= 0;
+			instr_add16  <= 0;
+			instr_sub16  <= 0;
+			instr_kadd16 <= 0;
+			instr_ksub16 <= 0;
+			instr_smbb16 <= 0;
+			instr_smtt16 <= 0;
+			instr_pkbb16 <= 0;
+			instr_pktt16 <= 0;
+			instr_sha256sig0  <= 0;
+			instr_sha256sig1  <= 0;
+			instr_sha256sum0  <= 0;
+			instr_sha256sum1  <= 0;
+			instr_sha512sig0l <= 0;
+			instr_sha512sig0h <= 0;
+			instr_sha512sig1l <= 0;
+			instr_sha512sig1h <= 0;
+			instr_sha512sum0r <= 0;
+			instr_sha512sum1r <= 0;
+			instr_lp_setup <= 0;
 
 			instr_fence <= 0;
 		end
@@ -1218,11 +1643,20 @@ module picorv32 #(
 	reg latched_is_lu;
 	reg latched_is_lh;
 	reg latched_is_lb;
+	reg latched_hwloop;
+	reg latched_btfn;
 	reg [regindex_bits-1:0] latched_rd;
 
 	reg [31:0] current_pc;
 	assign next_pc = latched_store && latched_branch ? reg_out & ~1 : reg_next_pc;
 
+	// Hardware loop: lp.setup loads lp_start with the address of the next
+	// instruction, lp_end with the address after the loop body and lp_count
+	// with the iteration count. When the instruction before lp_end is fetched
+	// and lp_count > 1, the next pc is redirected to lp_start, so the loop
+	// costs no branch instruction.
+	reg [31:0] lp_start, lp_end, lp_count;
+
 	reg [3:0] pcpi_timeout_counter;
 	reg pcpi_timeout;
 
@@ -1233,10 +1667,44 @@ module picorv32 #(
 	reg alu_out_0, alu_out_0_q;
 	reg alu_wait, alu_wait_2;
 
+	// ALU instructions with registered datapath stages stay in cpu_state_exec
+	// for one (alu_wait_insn) or two (alu_wait_insn_2) extra cycles, using the
+	// alu_wait/alu_wait_2 mechanism of TWO_CYCLE_ALU.
+	wire alu_wait_insn = (ENABLE_KYBER_NTT && is_kyber_ct_gs) || (ENABLE_AES32 && is_aes32);
+	wire alu_wait_insn_2 = ENABLE_KYBER_NTT && is_kyber_ct_gs;
+
 	reg [31:0] alu_add_sub;
 	reg [31:0] alu_shl, alu_shr;
 	reg alu_eq, alu_ltu, alu_lts;
 
+	// With ENABLE_BTFN backward branches are predicted taken (btfn_taken): the
+	// prefetch of the next instruction is skipped in the launch cycle and the
+	// branch target is prefetched instead from cpu_state_ld_rs1 on, with
+	// latched_btfn set. A branch that is taken then continues with the target
+	// right away. A branch that is not taken waits for the target prefetch and
+	// fetches the next instruction. count_bmiss counts the branches that went
+	// the other way than predicted (rdbmiss, csr 0xc03).
+	wire btfn_taken = ENABLE_BTFN && is_beq_bne_blt_bge_bltu_bgeu && branch_bwd;
+
+	// With ENABLE_PIPELINE the basic ALU instructions and the conditional branches
+	// are executed in cpu_state_ld_rs1, with the register file outputs fed to the
+	// ALU directly (pipe_exec). The next instruction is already requested in the
+	// launch cycle (pipe_fetch), so with a zero-wait-state memory it arrives and
+	// is decoded during cpu_state_ld_rs1 and is launched in the following fetch
+	// cycle, together with the write back of the ALU result. Branches are
+	// predicted not taken: a taken branch goes through cpu_state_exec and
+	// discards the prefetched instruction.
+	wire pipe_insn = instr_lui || instr_auipc || instr_addi || instr_slti || instr_sltiu || instr_xori || instr_ori || instr_andi ||
+			instr_add || instr_sub || instr_slt || instr_sltu || instr_xor || instr_or || instr_and || is_beq_bne_blt_bge_bltu_bgeu;
+	wire pipe_exec = WITH_PIPELINE && cpu_state == cpu_state_ld_rs1 && pipe_insn;
+
+	assign pipe_fetch_pc = reg_next_pc + (compressed_instr ? 2 : 4);
+	assign pipe_fetch = WITH_PIPELINE && launch_next_insn && !mem_busy && !mem_state && !latched_branch && !latched_hwloop && !irq_state &&
+			(instr_lui || instr_auipc || is_alu_reg_imm || is_alu_reg_reg || (is_beq_bne_blt_bge_bltu_bgeu && !btfn_taken)) &&
+			!(COMPRESSED_ISA && pipe_fetch_pc[1]) && !(ENABLE_HWLOOP && lp_count && pipe_fetch_pc == lp_end);
+	assign pipe_rinst = pipe_exec && mem_do_prefetch && (!is_beq_bne_blt_bge_bltu_bgeu || !alu_out_0);
+	reg [31:0] alu_op1, alu_op2;
+
 	generate if (TWO_CYCLE_ALU) begin
 		always @(posedge clk) begin
 			alu_add_sub <= instr_sub ? reg_op1 - reg_op2 : reg_op1 + reg_op2;
@@ -1248,15 +1716,468 @@ module picorv32 #(
 		end
 	end else begin
 		always @* begin
-			alu_add_sub = instr_sub ? reg_op1 - reg_op2 : reg_op1 + reg_op2;
-			alu_eq = reg_op1 == reg_op2;
-			alu_lts = $signed(reg_op1) < $signed(reg_op2);
-			alu_ltu = reg_op1 < reg_op2;
+			alu_add_sub = instr_sub ? alu_op1 - alu_op2 : alu_op1 + alu_op2;
+			alu_eq = alu_op1 == alu_op2;
+			alu_lts = $signed(alu_op1) < $signed(alu_op2);
+			alu_ltu = alu_op1 < alu_op2;
 			alu_shl = reg_op1 << reg_op2[4:0];
 			alu_shr = $signed({instr_sra || instr_srai ? reg_op1[31] : 1'b0, reg_op1}) >>> reg_op2[4:0];
 		end
 	end endgenerate
 
+	// Kyber NTT butterfly (kyber_ct / kyber_gs)
+	//
+	// reg_op1 holds the packed coefficient pair {r[j+len], r[j]} and reg_op2[15:0]
+	// the zeta. kyber_ct returns {a - t, a + t} with t = fqmul(zeta, b) (forward
+	// NTT), kyber_gs returns {fqmul(zeta, b - a), barrett_reduce(a + b)} (inverse
+	// NTT). All arithmetic matches the int16_t semantics of the reference code.
+	//
+	// The multiplications are split over three cycles in cpu_state_exec (see
+	// alu_wait_insn): zeta * b and the Barrett quotient are registered in the
+	// first cycle, the product with QINV in the second, and the subtraction of
+	// the multiples of q is done in the third.
+
+	reg [31:0] kyber_ntt_out;
+	reg [31:0] kyber_ntt_a, kyber_ntt_b, kyber_ntt_zeta, kyber_ntt_factor;
+	reg [31:0] kyber_ntt_sum, kyber_ntt_diff, kyber_ntt_qinv;
+	reg [31:0] kyber_ntt_mont, kyber_ntt_barrett;
+	reg [31:0] kyber_ntt_prod_q;
+	reg [15:0] kyber_ntt_qinv_q, kyber_ntt_bq_q;
+
+	always @(posedge clk) begin
+		kyber_ntt_prod_q <= kyber_ntt_zeta * kyber_ntt_factor;
+		kyber_ntt_qinv_q <= kyber_ntt_prod_q[15:0] * 16'h f301; // QINV = -3327
+
+		// barrett_reduce(a + b) with v = ((1 << 26) + KYBER_Q / 2) / KYBER_Q
+		kyber_ntt_bq_q <= $signed(kyber_ntt_sum * 20159 + (1 << 25)) >>> 26;
+	end
+
+	always @* begin
+		kyber_ntt_a = {{16{reg_op1[15]}}, reg_op1[15:0]};
+		kyber_ntt_b = {{16{reg_op1[31]}}, reg_op1[31:16]};
+		kyber_ntt_zeta = {{16{reg_op2[15]}}, reg_op2[15:0]};
+
+		kyber_ntt_sum = kyber_ntt_a + kyber_ntt_b;
+		kyber_ntt_sum = {{16{kyber_ntt_sum[15]}}, kyber_ntt_sum[15:0]};
+		kyber_ntt_diff = kyber_ntt_b - kyber_ntt_a;
+		kyber_ntt_diff = {{16{kyber_ntt_diff[15]}}, kyber_ntt_diff[15:0]};
+
+		// t = montgomery_reduce(zeta * b) resp. montgomery_reduce(zeta * (b - a))
+		kyber_ntt_factor = instr_kyber_gs ? kyber_ntt_diff : kyber_ntt_b;
+		kyber_ntt_qinv = {{16{kyber_ntt_qinv_q[15]}}, kyber_ntt_qinv_q};
+		kyber_ntt_mont = kyber_ntt_prod_q - kyber_ntt_qinv * 3329;
+
+		kyber_ntt_barrett = kyber_ntt_sum - kyber_ntt_bq_q * 3329;
+
+		if (instr_kyber_gs) begin
+			kyber_ntt_out = {kyber_ntt_mont[31:16], kyber_ntt_barrett[15:0]};
+		end else begin
+			kyber_ntt_out[15:0] = kyber_ntt_a + kyber_ntt_mont[31:16];
+			kyber_ntt_out[31:16] = kyber_ntt_a - kyber_ntt_mont[31:16];
+		end
+	end
+
+	// Kyber centered binomial sampling (kyber_cbd2 / kyber_cbd3)
+	//
+	// Two coefficients per instruction, returned as packed int16_t. kyber_cbd2
+	// (eta = 2) uses byte reg_op2[1:0] of reg_op1, kyber_cbd3 (eta = 3) uses
+	// the 12-bit group reg_op2[0] of the 24-bit word in reg_op1. Each
+	// coefficient is the number of set bits in the lower half of its bit
+	// group minus the number of set bits in the upper half.
+
+	reg [31:0] kyber_cbd_out;
+	reg [11:0] kyber_cbd_bits;
+
+	always @* begin
+		if (instr_kyber_cbd3) begin
+			kyber_cbd_bits = reg_op2[0] ? reg_op1[23:12] : reg_op1[11:0];
+			kyber_cbd_out[15:0] = kyber_cbd_bits[0] + kyber_cbd_bits[1] + kyber_cbd_bits[2] -
+					kyber_cbd_bits[3] - kyber_cbd_bits[4] - kyber_cbd_bits[5];
+			kyber_cbd_out[31:16] = kyber_cbd_bits[6] + kyber_cbd_bits[7] + kyber_cbd_bits[8] -
+					kyber_cbd_bits[9] - kyber_cbd_bits[10] - kyber_cbd_bits[11];
+		end else begin
+			kyber_cbd_bits = reg_op1[8*reg_op2[1:0] +: 8];
+			kyber_cbd_out[15:0] = kyber_cbd_bits[0] + kyber_cbd_bits[1] - kyber_cbd_bits[2] - kyber_cbd_bits[3];
+			kyber_cbd_out[31:16] = kyber_cbd_bits[4] + kyber_cbd_bits[5] - kyber_cbd_bits[6] - kyber_cbd_bits[7];
+		end
+	end
+
+	// Rejection sampling of uniform coefficients (kyber_rej / dilithium_rej)
+	//
+	// kyber_rej splits the 24-bit word in reg_op1 into two 12-bit candidates
+	// and returns the ones that are smaller than q = 3329, in order, in bits
+	// 11:0 and 27:16, with the number of accepted candidates in bits 31:30.
+	// dilithium_rej returns the 23-bit candidate in reg_op1 with bit 31 set
+	// if it is smaller than Q = 8380417.
+
+	reg [31:0] rej_out;
+	reg [11:0] rej_val0, rej_val1;
+	reg rej_ok0, rej_ok1;
+
+	always @* begin
+		rej_val0 = reg_op1[11:0];
+		rej_val1 = reg_op1[23:12];
+		rej_ok0 = rej_val0 < 3329;
+		rej_ok1 = rej_val1 < 3329;
+
+		if (instr_dilithium_rej) begin
+			rej_out = {reg_op1[22:0] < 8380417, 8'b0, reg_op1[22:0]};
+		end else begin
+			rej_out = 0;
+			rej_out[31:30] = rej_ok0 + rej_ok1;
+			rej_out[11:0] = rej_ok0 ? rej_val0 : rej_ok1 ? rej_val1 : 12'b0;
+			rej_out[27:16] = rej_ok0 && rej_ok1 ? rej_val1 : 12'b0;
+		end
+	end
+
+	// Kyber coefficient (de)compression (kyber_compress / kyber_decompress)
+	//
+	// Two coefficients per instruction in the 16-bit halves of reg_op1, with
+	// d = reg_op2[3:0] in 1..11. kyber_compress returns round(x * 2^d / q)
+	// mod 2^d for -q < x < q (negative x is mapped to x + q first), using a
+	// multiplication with ceil(2^33 / q) and a rounding shift, which is exact
+	// for all x < q. kyber_decompress returns round(x * q / 2^d) for the d-bit
+	// value x, computed from x aligned to 11 bits as (x * q + 2^10) >> 11.
+
+	reg [31:0] kyber_compress_out;
+	reg [15:0] kyber_compress_mask;
+	reg [11:0] kyber_compress_x;
+	reg [33:0] kyber_compress_f;
+	reg [10:0] kyber_decompress_x;
+	integer kyber_compress_i;
+
+	always @* begin
+		kyber_compress_mask = ~(16'h ffff << reg_op2[3:0]);
+		for (kyber_compress_i = 0; kyber_compress_i < 2; kyber_compress_i = kyber_compress_i+1) begin
+			if (instr_kyber_decompress) begin
+				kyber_decompress_x = (reg_op1[16*kyber_compress_i +: 16] & kyber_compress_mask) << (11 - reg_op2[3:0]);
+				kyber_compress_out[16*kyber_compress_i +: 16] = (kyber_decompress_x * 3329 + 1024) >> 11;
+			end else begin
+				kyber_compress_x = reg_op1[16*kyber_compress_i +: 16] + (reg_op1[16*kyber_compress_i+15] ? 3329 : 0);
+				kyber_compress_f = kyber_compress_x * 2580335 + (34'b1 << (32 - reg_op2[3:0]));
+				kyber_compress_out[16*kyber_compress_i +: 16] = (kyber_compress_f >> (33 - reg_op2[3:0])) & kyber_compress_mask;
+			end
+		end
+	end
+
+	// Dilithium3 rounding (dilithium_decompose / dilithium_power2round /
+	// dilithium_make_hint / dilithium_use_hint)
+	//
+	// reg_op1 is a standard representative 0 <= a < Q (Q = 8380417) for all
+	// but make_hint. decompose returns {a1, a0} for ALPHA = 2 * GAMMA2 =
+	// (Q - 1) / 16 with a1 in bits 31:28 and a0 as a signed value in bits
+	// 27:0, power2round returns {a1, a0} for D = 13 with a1 in bits 31:22
+	// and a0 in bits 21:0. make_hint returns the hint bit for low bits
+	// a0 = reg_op1 and high bits a1 = reg_op2, use_hint returns the high
+	// bits of reg_op1 corrected by hint bit reg_op2[0].
+
+	reg [31:0] dilithium_round_out;
+	reg [15:0] dilithium_round_t;
+	reg [3:0] dilithium_round_a1;
+	reg [31:0] dilithium_round_a0;
+	reg [31:0] dilithium_round_p2r;
+	reg [3:0] dilithium_round_hint;
+
+	always @* begin
+		dilithium_round_t = (reg_op1[22:0] + 127) >> 7;
+		dilithium_round_a1 = (dilithium_round_t * 1025 + (1 << 21)) >> 22;
+		dilithium_round_a0 = reg_op1[22:0] - dilithium_round_a1 * 523776;
+		if ($signed(dilithium_round_a0) > (8380417 - 1) / 2)
+			dilithium_round_a0 = dilithium_round_a0 - 8380417;
+
+		dilithium_round_hint = $signed(dilithium_round_a0) > 0 ? dilithium_round_a1 + 1 : dilithium_round_a1 - 1;
+		dilithium_round_p2r = reg_op1 + 4095;
+
+		(* parallel_case *)
+		case (1'b1)
+			instr_dilithium_power2round:
+				dilithium_round_out = {dilithium_round_p2r[22:13], reg_op1[21:0] - {dilithium_round_p2r[21:13], 13'b0}};
+			instr_dilithium_make_hint:
+				dilithium_round_out = $signed(reg_op1) > 261888 || $signed(reg_op1) < -261888 || (reg_op1 == -261888 && |reg_op2);
+			instr_dilithium_use_hint:
+				dilithium_round_out = reg_op2[0] ? dilithium_round_hint : dilithium_round_a1;
+			default:
+				dilithium_round_out = {dilithium_round_a1, dilithium_round_a0[27:0]};
+		endcase
+	end
+
+	// GF(2^12) multiplication (gfmul12), modulus x^12 + x^3 + 1
+
+	reg [31:0] gfmul12_out;
+	reg [22:0] gfmul12_prod;
+	integer gfmul12_i;
+
+	always @* begin
+		gfmul12_prod = 0;
+		for (gfmul12_i = 0; gfmul12_i < 12; gfmul12_i = gfmul12_i+1)
+			if (reg_op2[gfmul12_i])
+				gfmul12_prod = gfmul12_prod ^ (reg_op1[11:0] << gfmul12_i);
+
+		for (gfmul12_i = 22; gfmul12_i >= 12; gfmul12_i = gfmul12_i-1)
+			if (gfmul12_prod[gfmul12_i])
+				gfmul12_prod = gfmul12_prod ^ (23'b 1_0000_0000_1001 << (gfmul12_i-12));
+
+		gfmul12_out = gfmul12_prod[11:0];
+	end
+
+	// AES round instructions (aes32esi, aes32esmi, aes32dsi, aes32dsmi)
+	//
+	// Byte aes32_bs of reg_op2 is passed through the forward (es) or inverse (ds)
+	// S-box, for the *mi variants multiplied by the matching MixColumns column,
+	// rotated into byte position aes32_bs and XORed into reg_op1. The S-box is
+	// computed as inversion in GF(2^8) (x^254) plus the affine transformation.
+	// Its output is registered (aes32_sbox_q), the instructions wait one extra
+	// cycle in cpu_state_exec for the MixColumns and XOR stage.
+
+	function [7:0] aes32_xtime;
+		input [7:0] x;
+		aes32_xtime = {x[6:0], 1'b0} ^ (x[7] ? 8'h 1b : 8'h 00);
+	endfunction
+
+	function [7:0] aes32_gmul;
+		input [7:0] a, b;
+		integer i;
+		reg [7:0] p, t;
+		begin
+			p = 0;
+			t = a;
+			for (i = 0; i < 8; i = i+1) begin
+				if (b[i]) p = p ^ t;
+				t = aes32_xtime(t);
+			end
+			aes32_gmul = p;
+		end
+	endfunction
+
+	function [7:0] aes32_inv;
+		input [7:0] x;
+		reg [7:0] x2, x3, x12, x15, x240, x252;
+		begin
+			x2 = aes32_gmul(x, x);
+			x3 = aes32_gmul(x2, x);
+			x12 = aes32_gmul(aes32_gmul(x3, x3), aes32_gmul(x3, x3));
+			x15 = aes32_gmul(x12, x3);
+			x240 = aes32_gmul(x15, x15);
+			x240 = aes32_gmul(x240, x240);
+			x240 = aes32_gmul(x240, x240);
+			x240 = aes32_gmul(x240, x240);
+			x252 = aes32_gmul(x240, x12);
+			aes32_inv = aes32_gmul(x252, x2);
+		end
+	endfunction
+
+	reg [31:0] aes32_out, aes32_mix;
+	reg [63:0] aes32_rot;
+	reg [7:0] aes32_in, aes32_aff, aes32_sbox, aes32_sbox_q;
+	reg aes32_dec;
+
+	always @(posedge clk) begin
+		aes32_sbox_q <= aes32_sbox;
+	end
+
+	always @* begin
+		aes32_dec = instr_aes32dsi || instr_aes32dsmi;
+		aes32_in = reg_op2[8*aes32_bs +: 8];
+
+		if (aes32_dec) begin
+			aes32_aff = {aes32_in[6:0], aes32_in[7]} ^ {aes32_in[4:0], aes32_in[7:5]} ^
+					{aes32_in[1:0], aes32_in[7:2]} ^ 8'h 05;
+			aes32_sbox = aes32_inv(aes32_aff);
+		end else begin
+			aes32_aff = aes32_inv(aes32_in);
+			aes32_sbox = aes32_aff ^ {aes32_aff[6:0], aes32_aff[7]} ^ {aes32_aff[5:0], aes32_aff[7:6]} ^
+					{aes32_aff[4:0], aes32_aff[7:5]} ^ {aes32_aff[3:0], aes32_aff[7:4]} ^ 8'h 63;
+		end
+
+		if (instr_aes32esmi)
+			aes32_mix = {aes32_gmul(aes32_sbox_q, 8'h 03), aes32_sbox_q, aes32_sbox_q, aes32_gmul(aes32_sbox_q, 8'h 02)};
+		else if (instr_aes32dsmi)
+			aes32_mix = {aes32_gmul(aes32_sbox_q, 8'h 0b), aes32_gmul(aes32_sbox_q, 8'h 0d),
+					aes32_gmul(aes32_sbox_q, 8'h 09), aes32_gmul(aes32_sbox_q, 8'h 0e)};
+		else
+			aes32_mix = {24'b0, aes32_sbox_q};
+
+		aes32_rot = {aes32_mix, aes32_mix} << {aes32_bs, 3'b000};
+		aes32_out = reg_op1 ^ aes32_rot[63:32];
+	end
+
+	// Zbkb bit manipulation instructions (rotates, logic-with-negate, pack,
+	// byte and bit reverse, bit interleaving)
+
+	reg [31:0] zbkb_out;
+	reg [63:0] zbkb_rot;
+	integer zbkb_i;
+
+	always @* begin
+		zbkb_out = 'bx;
+		zbkb_rot = 'bx;
+		(* parallel_case, full_case *)
+		case (1'b1)
+			instr_ror || instr_rori: begin
+				zbkb_rot = {reg_op1, reg_op1} >> reg_op2[4:0];
+				zbkb_out = zbkb_rot[31:0];
+			end
+			instr_rol: begin
+				zbkb_rot = {reg_op1, reg_op1} << reg_op2[4:0];
+				zbkb_out = zbkb_rot[63:32];
+			end
+			instr_andn:
+				zbkb_out = reg_op1 & ~reg_op2;
+			instr_orn:
+				zbkb_out = reg_op1 | ~reg_op2;
+			instr_xnor:
+				zbkb_out = ~(reg_op1 ^ reg_op2);
+			instr_pack:
+				zbkb_out = {reg_op2[15:0], reg_op1[15:0]};
+			instr_packh:
+				zbkb_out = {16'b0, reg_op2[7:0], reg_op1[7:0]};
+			instr_rev8:
+				zbkb_out = {reg_op1[7:0], reg_op1[15:8], reg_op1[23:16], reg_op1[31:24]};
+			instr_brev8:
+				for (zbkb_i = 0; zbkb_i < 32; zbkb_i = zbkb_i+1)
+					zbkb_out[zbkb_i] = reg_op1[zbkb_i ^ 7];
+			instr_zip:
+				for (zbkb_i = 0; zbkb_i < 16; zbkb_i = zbkb_i+1) begin
+					zbkb_out[2*zbkb_i] = reg_op1[zbkb_i];
+					zbkb_out[2*zbkb_i+1] = reg_op1[zbkb_i+16];
+				end
+			instr_unzip:
+				for (zbkb_i = 0; zbkb_i < 16; zbkb_i = zbkb_i+1) begin
+					zbkb_out[zbkb_i] = reg_op1[2*zbkb_i];
+					zbkb_out[zbkb_i+16] = reg_op1[2*zbkb_i+1];
+				end
+		endcase
+	end
+
+	// Zbp generalized bit permutations (grev[i], shfl[i], unshfl[i]) and packu.
+	// The control value is reg_op2[4:0] for grev and reg_op2[3:0] for
+	// [un]shfl. brev8, rev8, zip and unzip are grevi 7, grevi 24, shfli 15
+	// and unshfli 15, and are executed here when ENABLE_ZBP is set. pack is
+	// also enabled by ENABLE_ZBP alone and is executed by the Zbkb logic.
+
+	reg [31:0] zbp_out;
+	reg [31:0] zbp_grev;
+	reg [31:0] zbp_shfl;
+	reg [31:0] zbp_unshfl;
+
+	always @* begin
+		zbp_grev = reg_op1;
+		if (reg_op2[0]) zbp_grev = ((zbp_grev & 32'h 5555_5555) << 1) | ((zbp_grev & 32'h aaaa_aaaa) >> 1);
+		if (reg_op2[1]) zbp_grev = ((zbp_grev & 32'h 3333_3333) << 2) | ((zbp_grev & 32'h cccc_cccc) >> 2);
+		if (reg_op2[2]) zbp_grev = ((zbp_grev & 32'h 0f0f_0f0f) << 4) | ((zbp_grev & 32'h f0f0_f0f0) >> 4);
+		if (reg_op2[3]) zbp_grev = ((zbp_grev & 32'h 00ff_00ff) << 8) | ((zbp_grev & 32'h ff00_ff00) >> 8);
+		if (reg_op2[4]) zbp_grev = {zbp_grev[15:0], zbp_grev[31:16]};
+
+		zbp_shfl = reg_op1;
+		if (reg_op2[3]) zbp_shfl = (zbp_shfl & 32'h ff00_00ff) | ((zbp_shfl << 8) & 32'h 00ff_0000) | ((zbp_shfl >> 8) & 32'h 0000_ff00);
+		if (reg_op2[2]) zbp_shfl = (zbp_shfl & 32'h f00f_f00f) | ((zbp_shfl << 4) & 32'h 0f00_0f00) | ((zbp_shfl >> 4) & 32'h 00f0_00f0);
+		if (reg_op2[1]) zbp_shfl = (zbp_shfl & 32'h c3c3_c3c3) | ((zbp_shfl << 2) & 32'h 3030_3030) | ((zbp_shfl >> 2) & 32'h 0c0c_0c0c);
+		if (reg_op2[0]) zbp_shfl = (zbp_shfl & 32'h 9999_9999) | ((zbp_shfl << 1) & 32'h 4444_4444) | ((zbp_shfl >> 1) & 32'h 2222_2222);
+
+		zbp_unshfl = reg_op1;
+		if (reg_op2[0]) zbp_unshfl = (zbp_unshfl & 32'h 9999_9999) | ((zbp_unshfl << 1) & 32'h 4444_4444) | ((zbp_unshfl >> 1) & 32'h 2222_2222);
+		if (reg_op2[1]) zbp_unshfl = (zbp_unshfl & 32'h c3c3_c3c3) | ((zbp_unshfl << 2) & 32'h 3030_3030) | ((zbp_unshfl >> 2) & 32'h 0c0c_0c0c);
+		if (reg_op2[2]) zbp_unshfl = (zbp_unshfl & 32'h f00f_f00f) | ((zbp_unshfl << 4) & 32'h 0f00_0f00) | ((zbp_unshfl >> 4) & 32'h 00f0_00f0);
+		if (reg_op2[3]) zbp_unshfl = (zbp_unshfl & 32'h ff00_00ff) | ((zbp_unshfl << 8) & 32'h 00ff_0000) | ((zbp_unshfl >> 8) & 32'h 0000_ff00);
+
+		zbp_out = 'bx;
+		(* parallel_case, full_case *)
+		case (1'b1)
+			instr_grev || instr_grevi:
+				zbp_out = zbp_grev;
+			instr_shfl || instr_shfli:
+				zbp_out = zbp_shfl;
+			instr_unshfl || instr_unshfli:
+				zbp_out = zbp_unshfl;
+			instr_packu:
+				zbp_out = {reg_op2[31:16], reg_op1[31:16]};
+		endcase
+	end
+
+	// Packed 2x16-bit SIMD instructions (subset of the RISC-V P extension).
+	// Halfword 0 is bits 15:0 ("bottom"), halfword 1 bits 31:16 ("top").
+	// kadd16/ksub16 saturate to the int16_t range, smbb16/smtt16 return the
+	// 32-bit product of the bottom/top halfwords.
+
+	reg [31:0] simd16_out;
+	reg [16:0] simd16_sum [0:1];
+	reg [31:0] simd16_prod;
+	integer simd16_i;
+
+	always @* begin
+		for (simd16_i = 0; simd16_i < 2; simd16_i = simd16_i+1) begin
+			if (instr_sub16 || instr_ksub16)
+				simd16_sum[simd16_i] = $signed(reg_op1[16*simd16_i +: 16]) - $signed(reg_op2[16*simd16_i +: 16]);
+			else
+				simd16_sum[simd16_i] = $signed(reg_op1[16*simd16_i +: 16]) + $signed(reg_op2[16*simd16_i +: 16]);
+		end
+
+		simd16_prod = $signed(instr_smtt16 ? reg_op1[31:16] : reg_op1[15:0]) *
+				$signed(instr_smtt16 ? reg_op2[31:16] : reg_op2[15:0]);
+
+		simd16_out = 'bx;
+		(* parallel_case, full_case *)
+		case (1'b1)
+			instr_add16 || instr_sub16:
+				simd16_out = {simd16_sum[1][15:0], simd16_sum[0][15:0]};
+			instr_kadd16 || instr_ksub16:
+				for (simd16_i = 0; simd16_i < 2; simd16_i = simd16_i+1) begin
+					case (simd16_sum[simd16_i][16:15])
+						2'b01: simd16_out[16*simd16_i +: 16] = 16'h 7fff;
+						2'b10: simd16_out[16*simd16_i +: 16] = 16'h 8000;
+						default: simd16_out[16*simd16_i +: 16] = simd16_sum[simd16_i][15:0];
+					endcase
+				end
+			instr_smbb16 || instr_smtt16:
+				simd16_out = simd16_prod;
+			instr_pkbb16:
+				simd16_out = {reg_op1[15:0], reg_op2[15:0]};
+			instr_pktt16:
+				simd16_out = {reg_op1[31:16], reg_op2[31:16]};
+		endcase
+	end
+
+	// Zknh SHA-256 and SHA-512 sigma functions (RV32 encodings). The SHA-512
+	// instructions take the two halves of a 64-bit operand in rs1 and rs2 and
+	// return one half of the result. sha512sum0r/sum1r return the low half
+	// for rs1 = lo, rs2 = hi and the high half for rs1 = hi, rs2 = lo;
+	// sha512sig*l expect rs1 = lo, rs2 = hi and sha512sig*h rs1 = hi, rs2 = lo.
+
+	reg [31:0] zknh_out;
+
+	function [31:0] zknh_ror;
+		input [31:0] x;
+		input [4:0] n;
+		zknh_ror = (x >> n) | (x << (32 - n));
+	endfunction
+
+	always @* begin
+		zknh_out = 'bx;
+		(* parallel_case, full_case *)
+		case (1'b1)
+			instr_sha256sig0:
+				zknh_out = zknh_ror(reg_op1, 7) ^ zknh_ror(reg_op1, 18) ^ (reg_op1 >> 3);
+			instr_sha256sig1:
+				zknh_out = zknh_ror(reg_op1, 17) ^ zknh_ror(reg_op1, 19) ^ (reg_op1 >> 10);
+			instr_sha256sum0:
+				zknh_out = zknh_ror(reg_op1, 2) ^ zknh_ror(reg_op1, 13) ^ zknh_ror(reg_op1, 22);
+			instr_sha256sum1:
+				zknh_out = zknh_ror(reg_op1, 6) ^ zknh_ror(reg_op1, 11) ^ zknh_ror(reg_op1, 25);
+			instr_sha512sum0r:
+				zknh_out = (reg_op1 << 25) ^ (reg_op1 << 30) ^ (reg_op1 >> 28) ^ (reg_op2 >> 7) ^ (reg_op2 >> 2) ^ (reg_op2 << 4);
+			instr_sha512sum1r:
+				zknh_out = (reg_op1 << 23) ^ (reg_op1 >> 14) ^ (reg_op1 >> 18) ^ (reg_op2 >> 9) ^ (reg_op2 << 18) ^ (reg_op2 << 14);
+			instr_sha512sig0l:
+				zknh_out = (reg_op1 >> 1) ^ (reg_op1 >> 7) ^ (reg_op1 >> 8) ^ (reg_op2 << 31) ^ (reg_op2 << 25) ^ (reg_op2 << 24);
+			instr_sha512sig0h:
+				zknh_out = (reg_op1 >> 1) ^ (reg_op1 >> 7) ^ (reg_op1 >> 8) ^ (reg_op2 << 31) ^ (reg_op2 << 24);
+			instr_sha512sig1l:
+				zknh_out = (reg_op1 << 3) ^ (reg_op1 >> 6) ^ (reg_op1 >> 19) ^ (reg_op2 >> 29) ^ (reg_op2 << 26) ^ (reg_op2 << 13);
+			instr_sha512sig1h:
+				zknh_out = (reg_op1 << 3) ^ (reg_op1 >> 6) ^ (reg_op1 >> 19) ^ (reg_op2 >> 29) ^ (reg_op2 << 13);
+		endcase
+	end
+
 	always @* begin
 		alu_out_0 = 'bx;
 		(* parallel_case, full_case *)
@@ -1283,13 +2204,33 @@ module picorv32 #(
 			is_compare:
 				alu_out = alu_out_0;
 			instr_xori || instr_xor:
-				alu_out = reg_op1 ^ reg_op2;
+				alu_out = alu_op1 ^ alu_op2;
 			instr_ori || instr_or:
-				alu_out = reg_op1 | reg_op2;
+				alu_out = alu_op1 | alu_op2;
 			instr_andi || instr_and:
-				alu_out = reg_op1 & reg_op2;
-			/*is_aes128:
-				alu_out = do something with reg_op1 ;*/
+				alu_out = alu_op1 & alu_op2;
+			ENABLE_KYBER_NTT && is_kyber_ct_gs:
+				alu_out = kyber_ntt_out;
+			ENABLE_KYBER_CBD && is_kyber_cbd:
+				alu_out = kyber_cbd_out;
+			ENABLE_REJ_UNIFORM && (instr_kyber_rej || instr_dilithium_rej):
+				alu_out = rej_out;
+			ENABLE_KYBER_COMPRESS && (instr_kyber_compress || instr_kyber_decompress):
+				alu_out = kyber_compress_out;
+			ENABLE_DILITHIUM_ROUND && is_dilithium_round:
+				alu_out = dilithium_round_out;
+			ENABLE_GFMUL12 && instr_gfmul12:
+				alu_out = gfmul12_out;
+			ENABLE_AES32 && is_aes32:
+				alu_out = aes32_out;
+			(ENABLE_ZBKB || ENABLE_ZBP) && is_zbkb:
+				alu_out = zbkb_out;
+			ENABLE_ZBP && is_zbp:
+				alu_out = zbp_out;
+			ENABLE_SIMD16 && is_simd16:
+				alu_out = simd16_out;
+			ENABLE_ZKNH && is_zknh:
+				alu_out = zknh_out;
 			BARREL_SHIFTER && (instr_sll || instr_slli):
 				alu_out = alu_shl;
 			BARREL_SHIFTER && (instr_srl || instr_srli || instr_sra || instr_srai):
@@ -1309,7 +2250,7 @@ module picorv32 #(
 		clear_prefetched_high_word = clear_prefetched_high_word_q;
 		if (!prefetched_high_word)
 			clear_prefetched_high_word = 0;
-		if (latched_branch || irq_state || !resetn)
+		if (latched_branch || latched_hwloop || latched_btfn || irq_state || !resetn)
 			clear_prefetched_high_word = COMPRESSED_ISA;
 	end
 
@@ -1317,8 +2258,14 @@ module picorv32 #(
 	reg [31:0] cpuregs_wrdata;
 	reg [31:0] cpuregs_rs1;
 	reg [31:0] cpuregs_rs2;
+	reg [31:0] cpuregs_rs3;
 	reg [regindex_bits-1:0] decoded_rs;
-	reg [31:0] t_kyber;
+
+	// Without ENABLE_REGS_DUALPORT, rs3 of an instruction for PCPI is read
+	// through the single read port in an extra ld_rs1 cycle before rs1.
+	reg rs3_loaded;
+	wire rs3_fetch = ENABLE_REGS_RS3 && !ENABLE_REGS_DUALPORT && WITH_PCPI &&
+			cpu_state == cpu_state_ld_rs1 && instr_trap && !rs3_loaded;
 
 	always @* begin
 		cpuregs_write = 0;
@@ -1365,23 +2312,27 @@ module picorv32 #(
 `ifndef RISCV_FORMAL_BLACKBOX_REGS
 			cpuregs_rs1 = decoded_rs1 ? cpuregs[decoded_rs1] : 0;
 			cpuregs_rs2 = decoded_rs2 ? cpuregs[decoded_rs2] : 0;
+			cpuregs_rs3 = ENABLE_REGS_RS3 && decoded_rs3 ? cpuregs[decoded_rs3] : 0;
 `else
 			cpuregs_rs1 = decoded_rs1 ? $anyseq : 0;
 			cpuregs_rs2 = decoded_rs2 ? $anyseq : 0;
+			cpuregs_rs3 = ENABLE_REGS_RS3 && decoded_rs3 ? $anyseq : 0;
 `endif
 		end else begin
-			decoded_rs = (cpu_state == cpu_state_ld_rs2) ? decoded_rs2 : decoded_rs1;
+			decoded_rs = (cpu_state == cpu_state_ld_rs2) ? decoded_rs2 : rs3_fetch ? decoded_rs3 : decoded_rs1;
 `ifndef RISCV_FORMAL_BLACKBOX_REGS
 			cpuregs_rs1 = decoded_rs ? cpuregs[decoded_rs] : 0;
 `else
 			cpuregs_rs1 = decoded_rs ? $anyseq : 0;
 `endif
 			cpuregs_rs2 = cpuregs_rs1;
+			cpuregs_rs3 = cpuregs_rs1;
 		end
 	end
 `else
 	wire[31:0] cpuregs_rdata1;
 	wire[31:0] cpuregs_rdata2;
+	wire[31:0] cpuregs_rdata3;
 
 	wire [5:0] cpuregs_waddr = latched_rd;
 	wire [5:0] cpuregs_raddr1 = ENABLE_REGS_DUALPORT ? decoded_rs1 : decoded_rs;
@@ -1398,21 +2349,87 @@ module picorv32 #(
 		.rdata2(cpuregs_rdata2)
 	);
 
+	// the third read port is a second copy of the register file
+	generate if (ENABLE_REGS_RS3 && ENABLE_REGS_DUALPORT) begin
+		wire [5:0] cpuregs_raddr3 = decoded_rs3;
+
+		`PICORV32_REGS cpuregs_rs3_copy (
+			.clk(clk),
+			.wen(resetn && cpuregs_write && latched_rd),
+			.waddr(cpuregs_waddr),
+			.raddr1(cpuregs_raddr3),
+			.raddr2(6'b0),
+			.wdata(cpuregs_wrdata),
+			.rdata1(cpuregs_rdata3),
+			.rdata2()
+		);
+	end else begin
+		assign cpuregs_rdata3 = 0;
+	end endgenerate
+
 	always @* begin
 		decoded_rs = 'bx;
 		if (ENABLE_REGS_DUALPORT) begin
 			cpuregs_rs1 = decoded_rs1 ? cpuregs_rdata1 : 0;
 			cpuregs_rs2 = decoded_rs2 ? cpuregs_rdata2 : 0;
+			cpuregs_rs3 = ENABLE_REGS_RS3 && decoded_rs3 ? cpuregs_rdata3 : 0;
 		end else begin
-			decoded_rs = (cpu_state == cpu_state_ld_rs2) ? decoded_rs2 : decoded_rs1;
+			decoded_rs = (cpu_state == cpu_state_ld_rs2) ? decoded_rs2 : rs3_fetch ? decoded_rs3 : decoded_rs1;
 			cpuregs_rs1 = decoded_rs ? cpuregs_rdata1 : 0;
 			cpuregs_rs2 = cpuregs_rs1;
+			cpuregs_rs3 = cpuregs_rs1;
 		end
 	end
 `endif
 
+	always @* begin
+		alu_op1 = reg_op1;
+		alu_op2 = reg_op2;
+		if (pipe_exec) begin
+			alu_op1 = instr_lui ? 0 : instr_auipc ? reg_pc : cpuregs_rs1;
+			alu_op2 = is_alu_reg_reg || is_beq_bne_blt_bge_bltu_bgeu ? cpuregs_rs2 : decoded_imm;
+		end
+	end
+
 	assign launch_next_insn = cpu_state == cpu_state_fetch && decoder_trigger && (!ENABLE_IRQ || irq_delay || irq_active || !(irq_pending & ~irq_mask));
 
+
+	// Performance Monitoring Counters
+	//
+	// For each bit n set in HPM_EVENTS there is a 32 bit counter for event n,
+	// readable with csrr rd, 0xc04+n (hpmcounter4 and up). A custom instruction
+	// is counted at the launch of the next instruction, as its decoder flags
+	// are still valid then (except after a pseudo trigger, where they already
+	// belong to the next instruction and the previous one was a load or store).
+
+	reg [32*hpm_events-1:0] count_hpm;
+	reg hpm_irq_entry;
+
+	wire hpm_irq_pending = ENABLE_IRQ && |(irq_pending & ~irq_mask) && !irq_active && !irq_delay;
+	wire hpm_custom_insn = |{is_kyber_ct_gs, is_kyber_cbd, is_dilithium_round, is_aes32, is_zbkb, is_zbp, is_simd16, is_zknh,
+			instr_gfmul12, instr_kyber_rej, instr_dilithium_rej, instr_kyber_compress, instr_kyber_decompress, instr_lp_setup} ||
+			(WITH_PCPI && instr_trap && (pcpi_insn[6:0] == 7'b0001011 || pcpi_insn[6:0] == 7'b0101011));
+
+	wire [hpm_events-1:0] hpm_event = {
+		hpm_irq_pending || hpm_irq_entry,                                   // 5: IRQ entry latency (cycles)
+		launch_next_insn && !decoder_pseudo_trigger && hpm_custom_insn,     // 4: custom instructions retired
+		WITH_PCPI && pcpi_valid && !pcpi_int_ready,                         // 3: PCPI wait cycles
+		cpu_state == cpu_state_fetch && latched_branch,                     // 2: taken branches and jumps
+		cpu_state == cpu_state_ldmem || cpu_state == cpu_state_stmem,       // 1: load/store cycles
+		cpu_state == cpu_state_fetch && !decoder_trigger                    // 0: fetch stall cycles
+	};
+
+	always @(posedge clk) begin : hpm_counters
+		integer n;
+		hpm_irq_entry <= resetn && (hpm_irq_pending || (hpm_irq_entry && irq_active && !launch_next_insn));
+		for (n = 0; n < hpm_events; n = n+1) begin
+			if (HPM_EVENTS[n])
+				count_hpm[32*n +: 32] <= resetn ? count_hpm[32*n +: 32] + hpm_event[n] : 0;
+			else
+				count_hpm[32*n +: 32] <= 0;
+		end
+	end
+
 	always @(posedge clk) begin
 		trap <= 0;
 		reg_sh <= 'bx;
@@ -1449,6 +2466,7 @@ module picorv32 #(
 		end else begin
 			count_cycle <= 'bx;
 			count_instr <= 'bx;
+			count_bmiss <= 'bx;
 		end
 
 		next_irq_pending = ENABLE_IRQ ? irq_pending & LATCHED_IRQ : 'bx;
@@ -1457,7 +2475,7 @@ module picorv32 #(
 			timer <= timer - 1;
 		end
 
-		decoder_trigger <= mem_do_rinst && mem_done;
+		decoder_trigger <= (mem_do_rinst || pipe_rinst) && mem_done;
 		decoder_trigger_q <= decoder_trigger;
 		decoder_pseudo_trigger <= 0;
 		decoder_pseudo_trigger_q <= decoder_pseudo_trigger;
@@ -1473,15 +2491,22 @@ module picorv32 #(
 			reg_next_pc <= PROGADDR_RESET;
 			if (ENABLE_COUNTERS)
 				count_instr <= 0;
+			if (ENABLE_COUNTERS && ENABLE_BTFN)
+				count_bmiss <= 0;
+			if (ENABLE_HWLOOP)
+				lp_count <= 0;
 			latched_store <= 0;
 			latched_stalu <= 0;
 			latched_branch <= 0;
+			latched_hwloop <= 0;
+			latched_btfn <= 0;
 			latched_trace <= 0;
 			latched_is_lu <= 0;
 			latched_is_lh <= 0;
 			latched_is_lb <= 0;
 			pcpi_valid <= 0;
 			pcpi_timeout <= 0;
+			rs3_loaded <= 0;
 			irq_active <= 0;
 			irq_delay <= 0;
 			irq_mask <= ~0;
@@ -1505,6 +2530,7 @@ module picorv32 #(
 			cpu_state_fetch: begin
 				mem_do_rinst <= !decoder_trigger && !do_waitirq;
 				mem_wordsize <= 0;
+				rs3_loaded <= 0;
 
 				current_pc = reg_next_pc;
 
@@ -1543,6 +2569,8 @@ module picorv32 #(
 				latched_store <= 0;
 				latched_stalu <= 0;
 				latched_branch <= 0;
+				latched_hwloop <= 0;
+				latched_btfn <= 0;
 				latched_is_lu <= 0;
 				latched_is_lh <= 0;
 				latched_is_lb <= 0;
@@ -1572,6 +2600,13 @@ module picorv32 #(
 					`debug($display("-- %-0t", $time);)
 					irq_delay <= irq_active;
 					reg_next_pc <= current_pc + (compressed_instr ? 2 : 4);
+					if (ENABLE_HWLOOP && lp_count && current_pc + (compressed_instr ? 2 : 4) == lp_end) begin
+						lp_count <= lp_count - 1;
+						if (lp_count != 1) begin
+							reg_next_pc <= lp_start;
+							latched_hwloop <= 1;
+						end
+					end
 					if (ENABLE_TRACE)
 						latched_trace <= 1;
 					if (ENABLE_COUNTERS) begin
@@ -1584,7 +2619,7 @@ module picorv32 #(
 						latched_branch <= 1;
 					end else begin
 						mem_do_rinst <= 0;
-						mem_do_prefetch <= !instr_jalr && !instr_retirq;
+						mem_do_prefetch <= !instr_jalr && !instr_retirq && !btfn_taken;
 						cpu_state <= cpu_state_ld_rs1;
 					end
 				end
@@ -1594,9 +2629,20 @@ module picorv32 #(
 				reg_op1 <= 'bx;
 				reg_op2 <= 'bx;
 
+				if (btfn_taken && !(pipe_exec && !alu_out_0)) begin
+					reg_next_pc <= reg_pc + decoded_imm;
+					latched_btfn <= 1;
+					mem_do_prefetch <= 1;
+				end
+
 				(* parallel_case *)
 				case (1'b1)
-					(CATCH_ILLINSN || WITH_PCPI) && instr_trap: begin
+					rs3_fetch: begin
+						`debug($display("LD_RS3: %2d 0x%08x", decoded_rs3, cpuregs_rs3);)
+						reg_op3 <= cpuregs_rs3;
+						rs3_loaded <= 1;
+					end
+					(CATCH_ILLINSN || WITH_PCPI) && instr_trap && !rs3_fetch: begin
 						if (WITH_PCPI) begin
 							`debug($display("LD_RS1: %2d 0x%08x", decoded_rs1, cpuregs_rs1);)
 							reg_op1 <= cpuregs_rs1;
@@ -1609,6 +2655,10 @@ module picorv32 #(
 								reg_op2 <= cpuregs_rs2;
 								dbg_rs2val <= cpuregs_rs2;
 								dbg_rs2val_valid <= 1;
+								if (ENABLE_REGS_RS3) begin
+									`debug($display("LD_RS3: %2d 0x%08x", decoded_rs3, cpuregs_rs3);)
+									reg_op3 <= cpuregs_rs3;
+								end
 								if (pcpi_int_ready) begin
 									mem_do_rinst <= 1;
 									pcpi_valid <= 0;
@@ -1652,7 +2702,36 @@ module picorv32 #(
 						latched_store <= 1;
 						cpu_state <= cpu_state_fetch;
 					end
-					is_lui_auipc_jal: begin
+					pipe_exec: begin
+						if (!instr_lui && !instr_auipc) begin
+							`debug($display("LD_RS1: %2d 0x%08x", decoded_rs1, cpuregs_rs1);)
+							dbg_rs1val <= cpuregs_rs1;
+							dbg_rs1val_valid <= 1;
+						end
+						if (is_alu_reg_reg || is_beq_bne_blt_bge_bltu_bgeu) begin
+							`debug($display("LD_RS2: %2d 0x%08x", decoded_rs2, cpuregs_rs2);)
+							dbg_rs2val <= cpuregs_rs2;
+							dbg_rs2val_valid <= 1;
+						end
+						reg_op1 <= cpuregs_rs1;
+						reg_op2 <= cpuregs_rs2;
+						mem_do_rinst <= mem_do_prefetch;
+						if (!is_beq_bne_blt_bge_bltu_bgeu) begin
+							reg_out <= alu_out;
+							latched_store <= 1;
+							cpu_state <= cpu_state_fetch;
+						end else
+						if (alu_out_0) begin
+							latched_rd <= 0;
+							latched_branch <= btfn_taken;
+							cpu_state <= btfn_taken ? cpu_state_fetch : cpu_state_exec;
+						end else begin
+							if (ENABLE_COUNTERS && btfn_taken)
+								count_bmiss <= count_bmiss + 1;
+							cpu_state <= cpu_state_fetch;
+						end
+					end
+					is_lui_auipc_jal && !pipe_exec: begin
 						reg_op1 <= instr_lui ? 0 : reg_pc;
 						reg_op2 <= decoded_imm;
 						if (TWO_CYCLE_ALU)
@@ -1661,6 +2740,16 @@ module picorv32 #(
 							mem_do_rinst <= mem_do_prefetch;
 						cpu_state <= cpu_state_exec;
 					end
+					HPM_EVENTS && instr_rdhpm: begin
+						reg_out <= count_hpm >> 32*(decoded_rs2 - 4);
+						latched_store <= 1;
+						cpu_state <= cpu_state_fetch;
+					end
+					ENABLE_COUNTERS && ENABLE_BTFN && instr_rdbmiss: begin
+						reg_out <= count_bmiss;
+						latched_store <= 1;
+						cpu_state <= cpu_state_fetch;
+					end
 					ENABLE_IRQ && ENABLE_IRQ_QREGS && instr_getq: begin
 						`debug($display("LD_RS1: %2d 0x%08x", decoded_rs1, cpuregs_rs1);)
 						reg_out <= cpuregs_rs1;
@@ -1678,25 +2767,6 @@ module picorv32 #(
 						latched_store <= 1;
 						cpu_state <= cpu_state_fetch;
 					end
-					instr_aes128: begin
-						// ((x<<1) ^ (((x>>7) & 1) * 0x1b));
-						if(((cpuregs_rs1>>7) & 1))
-							reg_out <= (cpuregs_rs1 << 1)^ 32'h1b;
-						else
-							reg_out <= (cpuregs_rs1 << 1)^ 32'h00;
-						latched_store <= 1;
-						cpu_state <= cpu_state_fetch;
-					end
-					instr_kyber: begin
-						//t = (int16_t)a * QINV;-3327
-						t_kyber = cpuregs_rs1 * -3327;
-						t_kyber = {16'b0000000000000000, t_kyber[15:0]};
-						//t = (a - (int32_t)t * KYBER_Q) >> 16;
-						t_kyber = t_kyber * 3329;
-						reg_out <= (cpuregs_rs1 - t_kyber) >> 16;
-						latched_store <= 1;
-						cpu_state <= cpu_state_fetch;
-					end
 					ENABLE_IRQ && instr_retirq: begin
 						eoi <= 0;
 						irq_active <= 0;
@@ -1726,6 +2796,15 @@ module picorv32 #(
 						dbg_rs1val_valid <= 1;
 						cpu_state <= cpu_state_fetch;
 					end
+					ENABLE_HWLOOP && instr_lp_setup: begin
+						`debug($display("LD_RS1: %2d 0x%08x", decoded_rs1, cpuregs_rs1);)
+						lp_start <= reg_next_pc;
+						lp_end <= reg_pc + decoded_imm;
+						lp_count <= cpuregs_rs1;
+						dbg_rs1val <= cpuregs_rs1;
+						dbg_rs1val_valid <= 1;
+						cpu_state <= cpu_state_fetch;
+					end
 					is_lb_lh_lw_lbu_lhu && !instr_trap: begin
 						`debug($display("LD_RS1: %2d 0x%08x", decoded_rs1, cpuregs_rs1);)
 						reg_op1 <= cpuregs_rs1;
@@ -1742,7 +2821,7 @@ module picorv32 #(
 						reg_sh <= decoded_rs2;
 						cpu_state <= cpu_state_shift;
 					end
-					is_jalr_addi_slti_sltiu_xori_ori_andi, is_slli_srli_srai && BARREL_SHIFTER: begin
+					is_jalr_addi_slti_sltiu_xori_ori_andi && !pipe_exec, is_zbkb_imm, is_zbp_imm, is_zknh_imm, is_slli_srli_srai && BARREL_SHIFTER: begin
 						`debug($display("LD_RS1: %2d 0x%08x", decoded_rs1, cpuregs_rs1);)
 						reg_op1 <= cpuregs_rs1;
 						dbg_rs1val <= cpuregs_rs1;
@@ -1775,8 +2854,8 @@ module picorv32 #(
 									cpu_state <= cpu_state_shift;
 								end
 								default: begin
-									if (TWO_CYCLE_ALU || (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu)) begin
-										alu_wait_2 <= TWO_CYCLE_ALU && (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu);
+									if (TWO_CYCLE_ALU || (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu) || alu_wait_insn) begin
+										alu_wait_2 <= (TWO_CYCLE_ALU && (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu)) || alu_wait_insn_2;
 										alu_wait <= 1;
 									end else
 										mem_do_rinst <= mem_do_prefetch;
@@ -1825,8 +2904,8 @@ module picorv32 #(
 						cpu_state <= cpu_state_shift;
 					end
 					default: begin
-						if (TWO_CYCLE_ALU || (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu)) begin
-							alu_wait_2 <= TWO_CYCLE_ALU && (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu);
+						if (TWO_CYCLE_ALU || (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu) || alu_wait_insn) begin
+							alu_wait_2 <= (TWO_CYCLE_ALU && (TWO_CYCLE_COMPARE && is_beq_bne_blt_bge_bltu_bgeu)) || alu_wait_insn_2;
 							alu_wait <= 1;
 						end else
 							mem_do_rinst <= mem_do_prefetch;
@@ -1837,10 +2916,27 @@ module picorv32 #(
 
 			cpu_state_exec: begin
 				reg_out <= reg_pc + decoded_imm;
-				if ((TWO_CYCLE_ALU || TWO_CYCLE_COMPARE) && (alu_wait || alu_wait_2)) begin
+				if (WITH_ALU_WAIT && (alu_wait || alu_wait_2)) begin
 					mem_do_rinst <= mem_do_prefetch && !alu_wait_2;
 					alu_wait <= alu_wait_2;
 				end else
+				if (ENABLE_BTFN && latched_btfn) begin
+					latched_rd <= 0;
+					if (TWO_CYCLE_COMPARE ? alu_out_0_q : alu_out_0) begin
+						latched_branch <= 1;
+						mem_do_rinst <= mem_do_prefetch;
+						cpu_state <= cpu_state_fetch;
+					end else begin
+						decoder_trigger <= 0;
+						set_mem_do_rinst = 1;
+						if (mem_done) begin
+							reg_next_pc <= reg_pc + (latched_compr ? 2 : 4);
+							if (ENABLE_COUNTERS)
+								count_bmiss <= count_bmiss + 1;
+							cpu_state <= cpu_state_fetch;
+						end
+					end
+				end else
 				if (is_beq_bne_blt_bge_bltu_bgeu) begin
 					latched_rd <= 0;
 					latched_store <= TWO_CYCLE_COMPARE ? alu_out_0_q : alu_out_0;
@@ -1850,6 +2946,8 @@ module picorv32 #(
 					if (TWO_CYCLE_COMPARE ? alu_out_0_q : alu_out_0) begin
 						decoder_trigger <= 0;
 						set_mem_do_rinst = 1;
+						if (ENABLE_COUNTERS && ENABLE_BTFN && mem_done)
+							count_bmiss <= count_bmiss + 1;
 					end
 				end else begin
 					latched_branch <= instr_jalr;
@@ -2446,6 +3544,336 @@ module picorv32_pcpi_fast_mul #(
 endmodule
 
 
+/***************************************************************
+ * picorv32_pcpi_kyber
+ ***************************************************************/
+
+// kyber_mont rd, rs1 (custom-1, f7=0000010, f3=001, rs2 is ignored):
+// rd = montgomery_reduce(rs1) for Q = 3329, i.e. the sign extended 16-bit
+// value (rs1 - (int16_t)(rs1 * QINV) * Q) >> 16.
+//
+// kyber_barrett rd, rs1 (custom-1, f7=0000010, f3=100, rs2 is ignored):
+// rd = {barrett_reduce(rs1[31:16]), barrett_reduce(rs1[15:0])}, i.e. the
+// centered representatives of two packed int16_t coefficients.
+//
+// kyber_mac rd, rs1, rs2, rs3 (custom-1 R4-type, f2=01, f3=000, ENABLE_MAC):
+// rd = (int16_t)(rs3 + fqmul(rs1, rs2)), i.e. the sign extended 16-bit sum of
+// rs3[15:0] and the Montgomery product of the int16_t values rs1[15:0] and
+// rs2[15:0]. This needs the third register read port (ENABLE_REGS_RS3). The
+// product of rs1 and rs2 is computed when the instruction is issued, and rs3
+// is added in the last stage of the Montgomery reduction.
+//
+// The two multiplications of each reduction are in separate pipeline
+// stages, the result is ready two cycles after the instruction is issued.
+// EXTRA_MUL_FFS adds registers in front of the first and after the last
+// multiplier (four cycles), EXTRA_INSN_FFS registers the instruction
+// decoder output, like in picorv32_pcpi_fast_mul.
+
+module picorv32_pcpi_kyber #(
+	parameter EXTRA_MUL_FFS = 0,
+	parameter EXTRA_INSN_FFS = 0,
+	parameter ENABLE_MAC = 0
+) (
+	input clk, resetn,
+
+	input             pcpi_valid,
+	input      [31:0] pcpi_insn,
+	input      [31:0] pcpi_rs1,
+	input      [31:0] pcpi_rs2,
+	input      [31:0] pcpi_rs3,
+	output            pcpi_wr,
+	output     [31:0] pcpi_rd,
+	output            pcpi_wait,
+	output            pcpi_ready
+);
+	localparam [15:0] KYBER_Q = 3329;
+	localparam [15:0] KYBER_QINV = 16'h f301; // -3327 = Q^-1 mod 2^16
+	localparam integer KYBER_V = 20159; // ((1 << 26) + Q/2) / Q
+
+	// index of the last pipeline stage, and the stages that block a new
+	// instruction (with EXTRA_INSN_FFS the decoder sees pcpi_valid one
+	// cycle late, so it must not restart in the cycle after pcpi_ready)
+	localparam integer LAST = EXTRA_MUL_FFS ? 4 : 2;
+	localparam [5:0] BUSY_MASK = (2 << (LAST + (EXTRA_INSN_FFS ? 1 : 0))) - 1;
+
+	wire pcpi_insn_valid = pcpi_valid && pcpi_insn[6:0] == 7'b0101011 &&
+			(((pcpi_insn[14:12] == 3'b001 || pcpi_insn[14:12] == 3'b100) && pcpi_insn[31:25] == 7'b0000010) ||
+			 (ENABLE_MAC && pcpi_insn[14:12] == 3'b000 && pcpi_insn[26:25] == 2'b01));
+	reg pcpi_insn_valid_q;
+
+	wire instr_kyber_mac = ENABLE_MAC && pcpi_insn[25];
+	wire [31:0] mac_p = $signed(pcpi_rs1[15:0]) * $signed(pcpi_rs2[15:0]);
+
+	wire instr_kyber_any = resetn && (EXTRA_INSN_FFS ? pcpi_insn_valid_q : pcpi_insn_valid);
+
+	reg [5:0] active;
+	reg barrett;
+	reg [31:0] a, a_q, a_t, rd, rd_q;
+	reg [15:0] t, bt0, bt1, c;
+
+	wire [31:0] a_in = EXTRA_MUL_FFS ? a_q : a;
+	wire [31:0] barrett_p0 = $signed(a_in[15:0]) * KYBER_V + (1 << 25);
+	wire [31:0] barrett_p1 = $signed(a_in[31:16]) * KYBER_V + (1 << 25);
+
+	always @(posedge clk) begin
+		pcpi_insn_valid_q <= pcpi_insn_valid;
+		if (active[0]) begin
+			a_q <= a;
+		end
+		if (active[EXTRA_MUL_FFS ? 1 : 0]) begin
+			a_t <= a_in;
+			t <= a_in[15:0] * KYBER_QINV;
+			bt0 <= $signed(barrett_p0) >>> 26;
+			bt1 <= $signed(barrett_p1) >>> 26;
+		end
+		if (active[EXTRA_MUL_FFS ? 2 : 1]) begin
+			if (barrett)
+				rd <= {a_t[31:16] - bt1 * KYBER_Q, a_t[15:0] - bt0 * KYBER_Q};
+			else
+				rd <= a_t - {{16{t[15]}}, t} * KYBER_Q + {c, 16'b0};
+		end
+		if (active[3]) begin
+			rd_q <= rd;
+		end
+	end
+
+	always @(posedge clk) begin
+		if (instr_kyber_any && !(active & BUSY_MASK)) begin
+			a <= instr_kyber_mac ? mac_p : pcpi_rs1;
+			c <= instr_kyber_mac ? pcpi_rs3[15:0] : 16'b0;
+			barrett <= pcpi_insn[14];
+			active[0] <= 1;
+		end else begin
+			active[0] <= 0;
+		end
+
+		active[5:1] <= active;
+
+		if (!resetn)
+			active <= 0;
+	end
+
+	wire [31:0] rd_out = EXTRA_MUL_FFS ? rd_q : rd;
+
+	assign pcpi_wr = active[LAST];
+	assign pcpi_wait = 0;
+	assign pcpi_ready = active[LAST];
+	assign pcpi_rd = barrett ? rd_out : {{16{rd_out[31]}}, rd_out[31:16]};
+endmodule
+
+
+/***************************************************************
+ * picorv32_pcpi_dilithium
+ ***************************************************************/
+
+// dilithium_mont rd, rs1, rs2 (custom-1, f7=0000011, f3=000):
+// rd = montgomery_reduce((int64_t)rs1 * rs2) for Q = 8380417, i.e.
+// rs1 * rs2 * 2^-32 mod Q in the range -Q < rd < Q. Fully pipelined,
+// the result is ready four cycles after the instruction is issued.
+
+module picorv32_pcpi_dilithium (
+	input clk, resetn,
+
+	input             pcpi_valid,
+	input      [31:0] pcpi_insn,
+	input      [31:0] pcpi_rs1,
+	input      [31:0] pcpi_rs2,
+	output            pcpi_wr,
+	output     [31:0] pcpi_rd,
+	output            pcpi_wait,
+	output            pcpi_ready
+);
+	localparam [31:0] DILITHIUM_Q = 8380417;
+	localparam [31:0] DILITHIUM_QINV = 58728449; // Q^-1 mod 2^32
+
+	wire instr_dilithium_mont = resetn && pcpi_valid && pcpi_insn[6:0] == 7'b0101011 &&
+			pcpi_insn[14:12] == 3'b000 && pcpi_insn[31:25] == 7'b0000011;
+
+	reg [3:0] active;
+	reg [31:0] rs1, rs2, t;
+	reg [63:0] prod, prod_q, rd;
+
+	always @(posedge clk) begin
+		if (active[0]) begin
+			prod <= $signed(rs1) * $signed(rs2);
+		end
+		if (active[1]) begin
+			prod_q <= prod;
+			t <= prod[31:0] * DILITHIUM_QINV;
+		end
+		if (active[2]) begin
+			rd <= prod_q - {{32{t[31]}}, t} * DILITHIUM_Q;
+		end
+	end
+
+	always @(posedge clk) begin
+		if (instr_dilithium_mont && !active) begin
+			rs1 <= pcpi_rs1;
+			rs2 <= pcpi_rs2;
+			active[0] <= 1;
+		end else begin
+			active[0] <= 0;
+		end
+
+		active[3:1] <= active;
+
+		if (!resetn)
+			active <= 0;
+	end
+
+	assign pcpi_wr = active[3];
+	assign pcpi_wait = 0;
+	assign pcpi_ready = active[3];
+	assign pcpi_rd = rd[63:32];
+endmodule
+
+
+/***************************************************************
+ * picorv32_pcpi_clmul
+ ***************************************************************/
+
+// Zbkc carry-less multiplication, clmul (f3=001) returns the lower and
+// clmulh (f3=011) the upper half of the 64 bit product. This core
+// processes STEPS_AT_ONCE bits of rs1 per cycle, picorv32_pcpi_fast_clmul
+// computes the full product in a single cycle.
+
+module picorv32_pcpi_clmul #(
+	parameter STEPS_AT_ONCE = 1
+) (
+	input clk, resetn,
+
+	input             pcpi_valid,
+	input      [31:0] pcpi_insn,
+	input      [31:0] pcpi_rs1,
+	input      [31:0] pcpi_rs2,
+	output reg        pcpi_wr,
+	output reg [31:0] pcpi_rd,
+	output reg        pcpi_wait,
+	output reg        pcpi_ready
+);
+	reg instr_clmul, instr_clmulh;
+	wire instr_any_clmul = |{instr_clmul, instr_clmulh};
+
+	reg pcpi_wait_q;
+	wire clmul_start = pcpi_wait && !pcpi_wait_q;
+
+	always @(posedge clk) begin
+		instr_clmul <= 0;
+		instr_clmulh <= 0;
+
+		if (resetn && pcpi_valid && pcpi_insn[6:0] == 7'b0110011 && pcpi_insn[31:25] == 7'b0000101) begin
+			case (pcpi_insn[14:12])
+				3'b001: instr_clmul <= 1;
+				3'b011: instr_clmulh <= 1;
+			endcase
+		end
+
+		pcpi_wait <= instr_any_clmul;
+		pcpi_wait_q <= pcpi_wait;
+	end
+
+	reg [31:0] rs1, next_rs1;
+	reg [63:0] rs2, rd, next_rs2, next_rd;
+	reg [5:0] clmul_counter;
+	reg clmul_waiting;
+	reg clmul_finish;
+	integer i;
+
+	always @* begin
+		next_rd = rd;
+		next_rs1 = rs1;
+		next_rs2 = rs2;
+
+		for (i = 0; i < STEPS_AT_ONCE; i=i+1) begin
+			if (next_rs1[0])
+				next_rd = next_rd ^ next_rs2;
+			next_rs1 = next_rs1 >> 1;
+			next_rs2 = next_rs2 << 1;
+		end
+	end
+
+	always @(posedge clk) begin
+		clmul_finish <= 0;
+		if (!resetn) begin
+			clmul_waiting <= 1;
+		end else
+		if (clmul_waiting) begin
+			rs1 <= pcpi_rs1;
+			rs2 <= {32'b0, pcpi_rs2};
+			rd <= 0;
+			clmul_counter <= 31 - STEPS_AT_ONCE;
+			clmul_waiting <= !clmul_start;
+		end else begin
+			rd <= next_rd;
+			rs1 <= next_rs1;
+			rs2 <= next_rs2;
+
+			clmul_counter <= clmul_counter - STEPS_AT_ONCE;
+			if (clmul_counter[5]) begin
+				clmul_finish <= 1;
+				clmul_waiting <= 1;
+			end
+		end
+	end
+
+	always @(posedge clk) begin
+		pcpi_wr <= 0;
+		pcpi_ready <= 0;
+		if (clmul_finish && resetn) begin
+			pcpi_wr <= 1;
+			pcpi_ready <= 1;
+			pcpi_rd <= instr_clmulh ? rd[63:32] : rd[31:0];
+		end
+	end
+endmodule
+
+module picorv32_pcpi_fast_clmul (
+	input clk, resetn,
+
+	input             pcpi_valid,
+	input      [31:0] pcpi_insn,
+	input      [31:0] pcpi_rs1,
+	input      [31:0] pcpi_rs2,
+	output            pcpi_wr,
+	output     [31:0] pcpi_rd,
+	output            pcpi_wait,
+	output            pcpi_ready
+);
+	wire instr_any_clmul = resetn && pcpi_valid && pcpi_insn[6:0] == 7'b0110011 && pcpi_insn[31:25] == 7'b0000101 &&
+			(pcpi_insn[14:12] == 3'b001 || pcpi_insn[14:12] == 3'b011);
+
+	reg active;
+	reg shift_out;
+	reg [63:0] prod, rd;
+	integer i;
+
+	always @* begin
+		prod = 0;
+		for (i = 0; i < 32; i = i+1)
+			if (pcpi_rs1[i])
+				prod = prod ^ ({32'b0, pcpi_rs2} << i);
+	end
+
+	always @(posedge clk) begin
+		if (instr_any_clmul && !active) begin
+			rd <= prod;
+			shift_out <= pcpi_insn[13];
+			active <= 1;
+		end else begin
+			active <= 0;
+		end
+
+		if (!resetn)
+			active <= 0;
+	end
+
+	assign pcpi_wr = active;
+	assign pcpi_wait = 0;
+	assign pcpi_ready = active;
+	assign pcpi_rd = shift_out ? rd[63:32] : rd[31:0];
+endmodule
+
+
 /***************************************************************
  * picorv32_pcpi_div
  ***************************************************************/
@@ -2543,6 +3971,220 @@ module picorv32_pcpi_div (
 endmodule
 
 
+/***************************************************************
+ * picorv32_pcpi_custom
+ ***************************************************************/
+
+// Dispatcher for accelerators in the custom-0 (0001011) and custom-1
+// (0101011) opcode spaces. It is connected to the external PCPI port of the
+// core (ENABLE_PCPI = 1) and routes each instruction that the core traps to
+// PCPI to one of SLOTS (1..8) accelerator slots. Slot i claims the instructions with
+// (insn & SLOT_MASK[32*i +: 32]) == SLOT_MATCH[32*i +: 32]; if several slots
+// match, the lowest slot wins. The default is custom-0 with funct3 = i, which
+// leaves funct7 (or rs3 and funct2 of an R4-type instruction) to the slot.
+//
+// A slot sees slot_valid[i] together with the shared slot_insn, slot_rs1,
+// slot_rs2 and slot_rs3 buses, all of which are held stable by the core
+// until the slot asserts slot_ready[i] (and slot_wr[i] to write
+// slot_rd[32*i +: 32] to rd). The dispatcher keeps pcpi_wait asserted while
+// a slot is busy, so slots can take any number of cycles and do not need a
+// wait output of their own; existing PCPI cores can be used as slots as-is.
+//
+// slot_rs3 is pcpi_rs3, the value of register insn[31:27]. Connect it to the
+// pcpi_rs3 output of the core (ENABLE_REGS_RS3), or tie it to zero when no
+// slot needs a third source operand.
+//
+// EXTRA_INSN_FFS registers the slot decoder, so the match logic is not in
+// series with the instruction register of the core. Slots then see
+// slot_valid one cycle after pcpi_valid.
+//
+// Custom instructions that are executed by the core itself (the IRQ
+// instructions in custom-0 with ENABLE_IRQ, and the enabled instructions of
+// the "Custom Instructions for Cryptography" section in custom-1) never
+// reach the dispatcher. The internal PCPI cores (ENABLE_KYBER_MONT,
+// ENABLE_DILITHIUM_MONT) do see the custom-1 encodings; the slot masks must
+// not overlap with enabled ones.
+
+module picorv32_pcpi_custom #(
+	parameter integer SLOTS = 4,
+	parameter [8*32-1:0] SLOT_MASK = {8{32'h 0000_707f}},
+	parameter [8*32-1:0] SLOT_MATCH = {
+		32'h 0000_700b, 32'h 0000_600b, 32'h 0000_500b, 32'h 0000_400b,
+		32'h 0000_300b, 32'h 0000_200b, 32'h 0000_100b, 32'h 0000_000b
+	},
+	parameter [ 0:0] EXTRA_INSN_FFS = 0
+) (
+	input clk, resetn,
+
+	input             pcpi_valid,
+	input      [31:0] pcpi_insn,
+	input      [31:0] pcpi_rs1,
+	input      [31:0] pcpi_rs2,
+	input      [31:0] pcpi_rs3,
+	output reg        pcpi_wr,
+	output reg [31:0] pcpi_rd,
+	output            pcpi_wait,
+	output reg        pcpi_ready,
+
+	output [SLOTS-1:0]    slot_valid,
+	output [31:0]         slot_insn,
+	output [31:0]         slot_rs1,
+	output [31:0]         slot_rs2,
+	output [31:0]         slot_rs3,
+	input  [SLOTS-1:0]    slot_wr,
+	input  [32*SLOTS-1:0] slot_rd,
+	input  [SLOTS-1:0]    slot_ready
+);
+	integer i, j;
+
+	reg [SLOTS-1:0] slot_sel;
+	reg [SLOTS-1:0] slot_sel_q;
+
+	always @* begin
+		slot_sel = 0;
+		for (i = SLOTS-1; i >= 0; i = i-1) begin
+			if ((pcpi_insn & SLOT_MASK[32*i +: 32]) == SLOT_MATCH[32*i +: 32])
+				slot_sel = 1 << i;
+		end
+		if (!resetn || !pcpi_valid)
+			slot_sel = 0;
+	end
+
+	// with EXTRA_INSN_FFS the decoder output must not survive the cycle
+	// in which the slot asserted ready, as pcpi_valid only drops after it
+	always @(posedge clk) begin
+		slot_sel_q <= pcpi_ready ? 0 : slot_sel;
+		if (!resetn)
+			slot_sel_q <= 0;
+	end
+
+	assign slot_valid = EXTRA_INSN_FFS ? slot_sel_q & {SLOTS{pcpi_valid}} : slot_sel;
+	assign slot_insn = pcpi_insn;
+	assign slot_rs1 = pcpi_rs1;
+	assign slot_rs2 = pcpi_rs2;
+	assign slot_rs3 = pcpi_rs3;
+
+	assign pcpi_wait = |slot_sel && !pcpi_ready;
+
+	always @* begin
+		pcpi_wr = 0;
+		pcpi_rd = 0;
+		pcpi_ready = 0;
+		for (j = 0; j < SLOTS; j = j+1) begin
+			if (slot_valid[j] && slot_ready[j]) begin
+				pcpi_wr = pcpi_wr | slot_wr[j];
+				pcpi_rd = pcpi_rd | slot_rd[32*j +: 32];
+				pcpi_ready = 1;
+			end
+		end
+	end
+endmodule
+
+
+/***************************************************************
+ * picorv32_icache
+ ***************************************************************/
+
+// Direct-mapped instruction cache with WORDS (a power of two) one-word lines
+// for the native memory interface. It sits between the core (mem_*) and the
+// memory (bus_*): instruction fetches that hit are answered from the cache,
+// fetches that miss are forwarded to the memory and fill the line. All other
+// transfers pass through unchanged. A write invalidates the line at its index,
+// so code that the core writes to memory is never served stale.
+//
+// The cache is looked up at mem_la_addr while mem_valid is low. Connect it to
+// the look-ahead interface of the core and a hit is answered in the first
+// cycle of mem_valid, i.e. without wait states. Otherwise (e.g. mem_la_addr
+// tied to zero) a hit costs one wait state for the lookup at mem_addr.
+//
+// icache_hits counts the fetches answered by the cache and icache_misses the
+// line fills.
+
+module picorv32_icache #(
+	parameter integer WORDS = 256
+) (
+	input clk, resetn,
+
+	input             mem_valid,
+	input             mem_instr,
+	output            mem_ready,
+	input      [31:0] mem_addr,
+	input      [31:0] mem_wdata,
+	input      [ 3:0] mem_wstrb,
+	output     [31:0] mem_rdata,
+	input      [31:0] mem_la_addr,
+
+	output            bus_valid,
+	output            bus_instr,
+	input             bus_ready,
+	output     [31:0] bus_addr,
+	output     [31:0] bus_wdata,
+	output     [ 3:0] bus_wstrb,
+	input      [31:0] bus_rdata,
+
+	output reg [31:0] icache_hits,
+	output reg [31:0] icache_misses
+);
+	localparam integer INDEX_BITS = $clog2(WORDS);
+
+	reg [31:0] cache_data [0:WORDS-1];
+	reg [29-INDEX_BITS:0] cache_tag [0:WORDS-1];
+	reg [WORDS-1:0] cache_valid;
+
+	wire [31:0] lookup_addr = mem_valid ? mem_addr : mem_la_addr;
+	wire [INDEX_BITS-1:0] mem_index = mem_addr[INDEX_BITS+1:2];
+
+	reg [29:0] lookup_q;
+	reg [31:0] lookup_data;
+	reg [29-INDEX_BITS:0] lookup_tag;
+	reg lookup_valid;
+
+	always @(posedge clk) begin
+		lookup_q <= lookup_addr[31:2];
+		lookup_data <= cache_data[lookup_addr[INDEX_BITS+1:2]];
+		lookup_tag <= cache_tag[lookup_addr[INDEX_BITS+1:2]];
+		lookup_valid <= cache_valid[lookup_addr[INDEX_BITS+1:2]];
+	end
+
+	wire fetch = mem_valid && mem_instr && !mem_wstrb;
+	wire lookup_done = lookup_q == mem_addr[31:2];
+	wire hit = fetch && lookup_done && lookup_valid && lookup_tag == mem_addr[31:INDEX_BITS+2];
+	wire miss = fetch && lookup_done && !hit;
+
+	assign bus_valid = mem_valid && (!fetch || miss);
+	assign bus_instr = mem_instr;
+	assign bus_addr = mem_addr;
+	assign bus_wdata = mem_wdata;
+	assign bus_wstrb = mem_wstrb;
+
+	assign mem_ready = hit || (bus_valid && bus_ready);
+	assign mem_rdata = hit ? lookup_data : bus_rdata;
+
+	always @(posedge clk) begin
+		if (miss && bus_ready) begin
+			cache_data[mem_index] <= bus_rdata;
+			cache_tag[mem_index] <= mem_addr[31:INDEX_BITS+2];
+		end
+	end
+
+	always @(posedge clk) begin
+		if (miss && bus_ready)
+			cache_valid[mem_index] <= 1;
+		if (mem_valid && mem_wstrb)
+			cache_valid[mem_index] <= 0;
+		if (hit)
+			icache_hits <= icache_hits + 1;
+		if (miss && bus_ready)
+			icache_misses <= icache_misses + 1;
+		if (!resetn) begin
+			cache_valid <= 0;
+			icache_hits <= 0;
+			icache_misses <= 0;
+		end
+	end
+endmodule
+
+
 /***************************************************************
  * picorv32_axi
  ***************************************************************/
@@ -2552,6 +4194,7 @@ module picorv32_axi #(
 	parameter [ 0:0] ENABLE_COUNTERS64 = 1,
 	parameter [ 0:0] ENABLE_REGS_16_31 = 1,
 	parameter [ 0:0] ENABLE_REGS_DUALPORT = 1,
+	parameter [ 0:0] ENABLE_REGS_RS3 = 0,
 	parameter [ 0:0] TWO_STAGE_SHIFT = 1,
 	parameter [ 0:0] BARREL_SHIFTER = 0,
 	parameter [ 0:0] TWO_CYCLE_COMPARE = 0,
@@ -2568,6 +4211,28 @@ module picorv32_axi #(
 	parameter [ 0:0] ENABLE_IRQ_TIMER = 1,
 	parameter [ 0:0] ENABLE_TRACE = 0,
 	parameter [ 0:0] REGS_INIT_ZERO = 0,
+	parameter [ 0:0] ENABLE_KYBER_NTT = 0,
+	parameter [ 0:0] ENABLE_KYBER_MONT = 0,
+	parameter [ 0:0] ENABLE_KYBER_CBD = 0,
+	parameter [ 0:0] ENABLE_REJ_UNIFORM = 0,
+	parameter [ 0:0] ENABLE_KYBER_COMPRESS = 0,
+	parameter [ 0:0] ENABLE_DILITHIUM_MONT = 0,
+	parameter [ 0:0] ENABLE_DILITHIUM_ROUND = 0,
+	parameter [ 0:0] ENABLE_GFMUL12 = 0,
+	parameter [ 0:0] ENABLE_AES32 = 0,
+	parameter [ 0:0] ENABLE_ZBKB = 0,
+	parameter [ 0:0] ENABLE_ZBP = 0,
+	parameter [ 0:0] ENABLE_CLMUL = 0,
+	parameter [ 0:0] ENABLE_FAST_CLMUL = 0,
+	parameter [ 0:0] ENABLE_SIMD16 = 0,
+	parameter [ 0:0] ENABLE_ZKNH = 0,
+	parameter [ 0:0] ENABLE_HWLOOP = 0,
+	parameter [ 0:0] ENABLE_PIPELINE = 0,
+	parameter [ 0:0] ENABLE_BTFN = 0,
+	parameter integer TCM_WORDS = 0,
+	parameter [31:0] TCM_ADDR = 32'h 0400_0000,
+	parameter integer ICACHE_WORDS = 0,
+	parameter [31:0] HPM_EVENTS = 32'h 0000_0000,
 	parameter [31:0] MASKED_IRQ = 32'h 0000_0000,
 	parameter [31:0] LATCHED_IRQ = 32'h ffff_ffff,
 	parameter [31:0] PROGADDR_RESET = 32'h 0000_0000,
@@ -2606,6 +4271,7 @@ module picorv32_axi #(
 	output [31:0] pcpi_insn,
 	output [31:0] pcpi_rs1,
 	output [31:0] pcpi_rs2,
+	output [31:0] pcpi_rs3,
 	input         pcpi_wr,
 	input  [31:0] pcpi_rd,
 	input         pcpi_wait,
@@ -2639,7 +4305,11 @@ module picorv32_axi #(
 
 	// Trace Interface
 	output        trace_valid,
-	output [35:0] trace_data
+	output [35:0] trace_data,
+
+	// Instruction cache statistics (ICACHE_WORDS > 0)
+	output [31:0] icache_hits,
+	output [31:0] icache_misses
 );
 	wire        mem_valid;
 	wire [31:0] mem_addr;
@@ -2648,6 +4318,51 @@ module picorv32_axi #(
 	wire        mem_instr;
 	wire        mem_ready;
 	wire [31:0] mem_rdata;
+	wire [31:0] mem_la_addr;
+
+	wire        bus_valid;
+	wire [31:0] bus_addr;
+	wire [31:0] bus_wdata;
+	wire [ 3:0] bus_wstrb;
+	wire        bus_instr;
+	wire        bus_ready;
+	wire [31:0] bus_rdata;
+
+	generate if (ICACHE_WORDS) begin
+		picorv32_icache #(
+			.WORDS(ICACHE_WORDS)
+		) icache (
+			.clk          (clk          ),
+			.resetn       (resetn       ),
+			.mem_valid    (mem_valid    ),
+			.mem_instr    (mem_instr    ),
+			.mem_ready    (mem_ready    ),
+			.mem_addr     (mem_addr     ),
+			.mem_wdata    (mem_wdata    ),
+			.mem_wstrb    (mem_wstrb    ),
+			.mem_rdata    (mem_rdata    ),
+			.mem_la_addr  (mem_la_addr  ),
+			.bus_valid    (bus_valid    ),
+			.bus_instr    (bus_instr    ),
+			.bus_ready    (bus_ready    ),
+			.bus_addr     (bus_addr     ),
+			.bus_wdata    (bus_wdata    ),
+			.bus_wstrb    (bus_wstrb    ),
+			.bus_rdata    (bus_rdata    ),
+			.icache_hits  (icache_hits  ),
+			.icache_misses(icache_misses)
+		);
+	end else begin
+		assign bus_valid = mem_valid;
+		assign bus_addr = mem_addr;
+		assign bus_wdata = mem_wdata;
+		assign bus_wstrb = mem_wstrb;
+		assign bus_instr = mem_instr;
+		assign mem_ready = bus_ready;
+		assign mem_rdata = bus_rdata;
+		assign icache_hits = 0;
+		assign icache_misses = 0;
+	end endgenerate
 
 	picorv32_axi_adapter axi_adapter (
 		.clk            (clk            ),
@@ -2669,13 +4384,13 @@ module picorv32_axi #(
 		.mem_axi_rvalid (mem_axi_rvalid ),
 		.mem_axi_rready (mem_axi_rready ),
 		.mem_axi_rdata  (mem_axi_rdata  ),
-		.mem_valid      (mem_valid      ),
-		.mem_instr      (mem_instr      ),
-		.mem_ready      (mem_ready      ),
-		.mem_addr       (mem_addr       ),
-		.mem_wdata      (mem_wdata      ),
-		.mem_wstrb      (mem_wstrb      ),
-		.mem_rdata      (mem_rdata      )
+		.mem_valid      (bus_valid      ),
+		.mem_instr      (bus_instr      ),
+		.mem_ready      (bus_ready      ),
+		.mem_addr       (bus_addr       ),
+		.mem_wdata      (bus_wdata      ),
+		.mem_wstrb      (bus_wstrb      ),
+		.mem_rdata      (bus_rdata      )
 	);
 
 	picorv32 #(
@@ -2683,6 +4398,7 @@ module picorv32_axi #(
 		.ENABLE_COUNTERS64   (ENABLE_COUNTERS64   ),
 		.ENABLE_REGS_16_31   (ENABLE_REGS_16_31   ),
 		.ENABLE_REGS_DUALPORT(ENABLE_REGS_DUALPORT),
+		.ENABLE_REGS_RS3     (ENABLE_REGS_RS3     ),
 		.TWO_STAGE_SHIFT     (TWO_STAGE_SHIFT     ),
 		.BARREL_SHIFTER      (BARREL_SHIFTER      ),
 		.TWO_CYCLE_COMPARE   (TWO_CYCLE_COMPARE   ),
@@ -2699,6 +4415,27 @@ module picorv32_axi #(
 		.ENABLE_IRQ_TIMER    (ENABLE_IRQ_TIMER    ),
 		.ENABLE_TRACE        (ENABLE_TRACE        ),
 		.REGS_INIT_ZERO      (REGS_INIT_ZERO      ),
+		.ENABLE_KYBER_NTT    (ENABLE_KYBER_NTT    ),
+		.ENABLE_KYBER_MONT   (ENABLE_KYBER_MONT   ),
+		.ENABLE_KYBER_CBD    (ENABLE_KYBER_CBD    ),
+		.ENABLE_REJ_UNIFORM  (ENABLE_REJ_UNIFORM  ),
+		.ENABLE_KYBER_COMPRESS(ENABLE_KYBER_COMPRESS),
+		.ENABLE_DILITHIUM_MONT(ENABLE_DILITHIUM_MONT),
+		.ENABLE_DILITHIUM_ROUND(ENABLE_DILITHIUM_ROUND),
+		.ENABLE_GFMUL12      (ENABLE_GFMUL12      ),
+		.ENABLE_AES32        (ENABLE_AES32        ),
+		.ENABLE_ZBKB         (ENABLE_ZBKB         ),
+		.ENABLE_ZBP          (ENABLE_ZBP          ),
+		.ENABLE_CLMUL        (ENABLE_CLMUL        ),
+		.ENABLE_FAST_CLMUL   (ENABLE_FAST_CLMUL   ),
+		.ENABLE_SIMD16       (ENABLE_SIMD16       ),
+		.ENABLE_ZKNH         (ENABLE_ZKNH         ),
+		.ENABLE_HWLOOP       (ENABLE_HWLOOP       ),
+		.ENABLE_PIPELINE     (ENABLE_PIPELINE     ),
+		.ENABLE_BTFN         (ENABLE_BTFN         ),
+		.TCM_WORDS           (TCM_WORDS           ),
+		.TCM_ADDR            (TCM_ADDR            ),
+		.HPM_EVENTS          (HPM_EVENTS          ),
 		.MASKED_IRQ          (MASKED_IRQ          ),
 		.LATCHED_IRQ         (LATCHED_IRQ         ),
 		.PROGADDR_RESET      (PROGADDR_RESET      ),
@@ -2717,10 +4454,13 @@ module picorv32_axi #(
 		.mem_ready(mem_ready),
 		.mem_rdata(mem_rdata),
 
+		.mem_la_addr(mem_la_addr),
+
 		.pcpi_valid(pcpi_valid),
 		.pcpi_insn (pcpi_insn ),
 		.pcpi_rs1  (pcpi_rs1  ),
 		.pcpi_rs2  (pcpi_rs2  ),
+		.pcpi_rs3  (pcpi_rs3  ),
 		.pcpi_wr   (pcpi_wr   ),
 		.pcpi_rd   (pcpi_rd   ),
 		.pcpi_wait (pcpi_wait ),
@@ -2850,6 +4590,7 @@ module picorv32_wb #(
 	parameter [ 0:0] ENABLE_COUNTERS64 = 1,
 	parameter [ 0:0] ENABLE_REGS_16_31 = 1,
 	parameter [ 0:0] ENABLE_REGS_DUALPORT = 1,
+	parameter [ 0:0] ENABLE_REGS_RS3 = 0,
 	parameter [ 0:0] TWO_STAGE_SHIFT = 1,
 	parameter [ 0:0] BARREL_SHIFTER = 0,
 	parameter [ 0:0] TWO_CYCLE_COMPARE = 0,
@@ -2866,6 +4607,27 @@ module picorv32_wb #(
 	parameter [ 0:0] ENABLE_IRQ_TIMER = 1,
 	parameter [ 0:0] ENABLE_TRACE = 0,
 	parameter [ 0:0] REGS_INIT_ZERO = 0,
+	parameter [ 0:0] ENABLE_KYBER_NTT = 0,
+	parameter [ 0:0] ENABLE_KYBER_MONT = 0,
+	parameter [ 0:0] ENABLE_KYBER_CBD = 0,
+	parameter [ 0:0] ENABLE_REJ_UNIFORM = 0,
+	parameter [ 0:0] ENABLE_KYBER_COMPRESS = 0,
+	parameter [ 0:0] ENABLE_DILITHIUM_MONT = 0,
+	parameter [ 0:0] ENABLE_DILITHIUM_ROUND = 0,
+	parameter [ 0:0] ENABLE_GFMUL12 = 0,
+	parameter [ 0:0] ENABLE_AES32 = 0,
+	parameter [ 0:0] ENABLE_ZBKB = 0,
+	parameter [ 0:0] ENABLE_ZBP = 0,
+	parameter [ 0:0] ENABLE_CLMUL = 0,
+	parameter [ 0:0] ENABLE_FAST_CLMUL = 0,
+	parameter [ 0:0] ENABLE_SIMD16 = 0,
+	parameter [ 0:0] ENABLE_ZKNH = 0,
+	parameter [ 0:0] ENABLE_HWLOOP = 0,
+	parameter [ 0:0] ENABLE_PIPELINE = 0,
+	parameter [ 0:0] ENABLE_BTFN = 0,
+	parameter integer TCM_WORDS = 0,
+	parameter [31:0] TCM_ADDR = 32'h 0400_0000,
+	parameter [31:0] HPM_EVENTS = 32'h 0000_0000,
 	parameter [31:0] MASKED_IRQ = 32'h 0000_0000,
 	parameter [31:0] LATCHED_IRQ = 32'h ffff_ffff,
 	parameter [31:0] PROGADDR_RESET = 32'h 0000_0000,
@@ -2892,6 +4654,7 @@ module picorv32_wb #(
 	output [31:0] pcpi_insn,
 	output [31:0] pcpi_rs1,
 	output [31:0] pcpi_rs2,
+	output [31:0] pcpi_rs3,
 	input         pcpi_wr,
 	input  [31:0] pcpi_rd,
 	input         pcpi_wait,
@@ -2947,6 +4710,7 @@ module picorv32_wb #(
 		.ENABLE_COUNTERS64   (ENABLE_COUNTERS64   ),
 		.ENABLE_REGS_16_31   (ENABLE_REGS_16_31   ),
 		.ENABLE_REGS_DUALPORT(ENABLE_REGS_DUALPORT),
+		.ENABLE_REGS_RS3     (ENABLE_REGS_RS3     ),
 		.TWO_STAGE_SHIFT     (TWO_STAGE_SHIFT     ),
 		.BARREL_SHIFTER      (BARREL_SHIFTER      ),
 		.TWO_CYCLE_COMPARE   (TWO_CYCLE_COMPARE   ),
@@ -2963,6 +4727,27 @@ module picorv32_wb #(
 		.ENABLE_IRQ_TIMER    (ENABLE_IRQ_TIMER    ),
 		.ENABLE_TRACE        (ENABLE_TRACE        ),
 		.REGS_INIT_ZERO      (REGS_INIT_ZERO      ),
+		.ENABLE_KYBER_NTT    (ENABLE_KYBER_NTT    ),
+		.ENABLE_KYBER_MONT   (ENABLE_KYBER_MONT   ),
+		.ENABLE_KYBER_CBD    (ENABLE_KYBER_CBD    ),
+		.ENABLE_REJ_UNIFORM  (ENABLE_REJ_UNIFORM  ),
+		.ENABLE_KYBER_COMPRESS(ENABLE_KYBER_COMPRESS),
+		.ENABLE_DILITHIUM_MONT(ENABLE_DILITHIUM_MONT),
+		.ENABLE_DILITHIUM_ROUND(ENABLE_DILITHIUM_ROUND),
+		.ENABLE_GFMUL12      (ENABLE_GFMUL12      ),
+		.ENABLE_AES32        (ENABLE_AES32        ),
+		.ENABLE_ZBKB         (ENABLE_ZBKB         ),
+		.ENABLE_ZBP          (ENABLE_ZBP          ),
+		.ENABLE_CLMUL        (ENABLE_CLMUL        ),
+		.ENABLE_FAST_CLMUL   (ENABLE_FAST_CLMUL   ),
+		.ENABLE_SIMD16       (ENABLE_SIMD16       ),
+		.ENABLE_ZKNH         (ENABLE_ZKNH         ),
+		.ENABLE_HWLOOP       (ENABLE_HWLOOP       ),
+		.ENABLE_PIPELINE     (ENABLE_PIPELINE     ),
+		.ENABLE_BTFN         (ENABLE_BTFN         ),
+		.TCM_WORDS           (TCM_WORDS           ),
+		.TCM_ADDR            (TCM_ADDR            ),
+		.HPM_EVENTS          (HPM_EVENTS          ),
 		.MASKED_IRQ          (MASKED_IRQ          ),
 		.LATCHED_IRQ         (LATCHED_IRQ         ),
 		.PROGADDR_RESET      (PROGADDR_RESET      ),
@@ -2985,6 +4770,7 @@ module picorv32_wb #(
 		.pcpi_insn (pcpi_insn ),
 		.pcpi_rs1  (pcpi_rs1  ),
 		.pcpi_rs2  (pcpi_rs2  ),
+		.pcpi_rs3  (pcpi_rs3  ),
 		.pcpi_wr   (pcpi_wr   ),
 		.pcpi_rd   (pcpi_rd   ),
 		.pcpi_wait (pcpi_wait ),
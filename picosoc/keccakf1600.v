@@ -0,0 +1,148 @@
+/*
+ *  PicoSoC - A simple example SoC using PicoRV32
+ *
+ *  Copyright (C) 2017  Claire Xenia Wolf <claire@yosyshq.com>
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+// Keccak-f[1600] permutation engine with a native (iomem style) memory
+// interface. The 256 byte register window is laid out as follows:
+//
+//   0x00 .. 0xC7   Keccak state, lane i in bytes 8*i .. 8*i+7 (little endian)
+//                  Reads return the state, writes XOR into the state.
+//   0xC8           Control: write bit 0 to start a permutation,
+//                  bit 1 to clear the state (clear happens first)
+//
+// A permutation takes 24 cycles (one round per cycle). Accesses to the
+// peripheral are stalled while a permutation is running.
+
+module keccakf1600 (
+	input clk,
+	input resetn,
+
+	input             valid,
+	output reg        ready,
+	input      [ 7:0] addr,
+	input      [ 3:0] wstrb,
+	input      [31:0] wdata,
+	output reg [31:0] rdata
+);
+	// rotation offsets for lane 5*y+x
+	localparam [25*6-1:0] RHO = {
+		6'd14, 6'd56, 6'd61, 6'd 2, 6'd18,
+		6'd 8, 6'd21, 6'd15, 6'd45, 6'd41,
+		6'd39, 6'd25, 6'd43, 6'd10, 6'd 3,
+		6'd20, 6'd55, 6'd 6, 6'd44, 6'd36,
+		6'd27, 6'd28, 6'd62, 6'd 1, 6'd 0
+	};
+
+	reg [1599:0] state;
+	reg [4:0] round;
+	reg busy;
+
+	reg [63:0] round_const;
+
+	always @* begin
+		(* full_case, parallel_case *)
+		case (round)
+			 0: round_const = 64'h 0000000000000001;
+			 1: round_const = 64'h 0000000000008082;
+			 2: round_const = 64'h 800000000000808a;
+			 3: round_const = 64'h 8000000080008000;
+			 4: round_const = 64'h 000000000000808b;
+			 5: round_const = 64'h 0000000080000001;
+			 6: round_const = 64'h 8000000080008081;
+			 7: round_const = 64'h 8000000000008009;
+			 8: round_const = 64'h 000000000000008a;
+			 9: round_const = 64'h 0000000000000088;
+			10: round_const = 64'h 0000000080008009;
+			11: round_const = 64'h 000000008000000a;
+			12: round_const = 64'h 000000008000808b;
+			13: round_const = 64'h 800000000000008b;
+			14: round_const = 64'h 8000000000008089;
+			15: round_const = 64'h 8000000000008003;
+			16: round_const = 64'h 8000000000008002;
+			17: round_const = 64'h 8000000000000080;
+			18: round_const = 64'h 000000000000800a;
+			19: round_const = 64'h 800000008000000a;
+			20: round_const = 64'h 8000000080008081;
+			21: round_const = 64'h 8000000000008080;
+			22: round_const = 64'h 0000000080000001;
+			23: round_const = 64'h 8000000080008008;
+			default: round_const = 64'h x;
+		endcase
+	end
+
+	// one Keccak round (theta, rho, pi, chi, iota)
+	reg [1599:0] round_out;
+	reg [63:0] theta_c [0:4];
+	reg [63:0] theta_d [0:4];
+	reg [63:0] lane, rho_pi [0:24];
+	integer x, y;
+
+	always @* begin
+		for (x = 0; x < 5; x = x+1)
+			theta_c[x] = state[64*x +: 64] ^ state[64*(x+5) +: 64] ^ state[64*(x+10) +: 64] ^
+					state[64*(x+15) +: 64] ^ state[64*(x+20) +: 64];
+
+		for (x = 0; x < 5; x = x+1)
+			theta_d[x] = theta_c[(x+4) % 5] ^ {theta_c[(x+1) % 5][62:0], theta_c[(x+1) % 5][63]};
+
+		for (y = 0; y < 5; y = y+1)
+		for (x = 0; x < 5; x = x+1) begin
+			lane = state[64*(5*y+x) +: 64] ^ theta_d[x];
+			rho_pi[5*((2*x+3*y) % 5) + y] = (lane << RHO[6*(5*y+x) +: 6]) | (lane >> (64 - RHO[6*(5*y+x) +: 6]));
+		end
+
+		for (y = 0; y < 5; y = y+1)
+		for (x = 0; x < 5; x = x+1)
+			round_out[64*(5*y+x) +: 64] = rho_pi[5*y+x] ^ (~rho_pi[5*y + (x+1) % 5] & rho_pi[5*y + (x+2) % 5]);
+
+		round_out[63:0] = round_out[63:0] ^ round_const;
+	end
+
+	always @(posedge clk) begin
+		ready <= 0;
+		if (!resetn) begin
+			busy <= 0;
+			round <= 0;
+		end else
+		if (busy) begin
+			state <= round_out;
+			round <= round + 1;
+			if (round == 23)
+				busy <= 0;
+		end else
+		if (valid && !ready) begin
+			ready <= 1;
+			rdata <= 0;
+			if (addr[7:2] < 50) begin
+				rdata <= state[32*addr[7:2] +: 32];
+				if (wstrb[0]) state[32*addr[7:2]      +: 8] <= state[32*addr[7:2]      +: 8] ^ wdata[ 7: 0];
+				if (wstrb[1]) state[32*addr[7:2] +  8 +: 8] <= state[32*addr[7:2] +  8 +: 8] ^ wdata[15: 8];
+				if (wstrb[2]) state[32*addr[7:2] + 16 +: 8] <= state[32*addr[7:2] + 16 +: 8] ^ wdata[23:16];
+				if (wstrb[3]) state[32*addr[7:2] + 24 +: 8] <= state[32*addr[7:2] + 24 +: 8] ^ wdata[31:24];
+			end
+			if (addr[7:2] == 50 && wstrb[0]) begin
+				if (wdata[1])
+					state <= 0;
+				if (wdata[0]) begin
+					busy <= 1;
+					round <= 0;
+				end
+			end
+		end
+	end
+endmodule
@@ -0,0 +1,356 @@
+/*
+ *  PicoSoC - A simple example SoC using PicoRV32
+ *
+ *  Copyright (C) 2017  Claire Xenia Wolf <claire@yosyshq.com>
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+// NTT engine for Kyber (q = 3329) and Dilithium (q = 8380417) with local
+// polynomial RAM and a native (iomem style) memory interface. The 8 kB
+// register window is laid out as follows:
+//
+//   0x0000 .. 0x03FF   polynomial 0, coefficient i in word i
+//   0x0400 .. 0x07FF   polynomial 1
+//   0x0800 .. 0x0BFF   polynomial 2
+//   0x0C00 .. 0x0FFF   twiddle factors, zetas[i] in word i
+//   0x1000             Control: write to start an operation, bits 2:0 select
+//                      the operation and bits 5:4 the polynomial n for NTT,
+//                      INVNTT and REDUCE. Writes with bits 5:4 = 3 are
+//                      ignored. Reads return 0.
+//   0x1004             Mode: bit 0 selects Dilithium (1) or Kyber (0)
+//
+// Coefficients are signed 32-bit words. In Kyber mode only bits 15:0 are
+// used and results are sign extended from bit 15. Only word accesses are
+// supported. The twiddle factors must be loaded with the zetas table of the
+// PQClean reference code of the scheme (128 entries for Kyber, 256 for
+// Dilithium). The operations give the same results as the reference code:
+//
+//   1  NTT     forward NTT of polynomial n, ntt()
+//   2  INVNTT  inverse NTT of polynomial n, invntt() / invntt_tomont()
+//   3  MUL     polynomial 2 = polynomial 0 * polynomial 1, poly_basemul_montgomery()
+//              (Kyber) or poly_pointwise_montgomery() (Dilithium)
+//   4  MAC     polynomial 2 += polynomial 0 * polynomial 1
+//   5  REDUCE  poly_reduce() of polynomial n
+//
+// The engine has one single ported coefficient RAM, one butterfly and a
+// three stage Montgomery multiplier. A butterfly takes 7 cycles, so an NTT
+// takes about 6300 (Kyber) or 7200 (Dilithium) cycles, INVNTT about 1300
+// cycles more. MUL and MAC take 11 cycles per Kyber coefficient pair or 6
+// cycles per Dilithium coefficient, REDUCE 2 cycles per coefficient.
+// Accesses to the peripheral are stalled while an operation is running, so
+// a read from the control register waits for the current operation.
+
+module ntt_engine (
+	input clk,
+	input resetn,
+
+	input             valid,
+	output reg        ready,
+	input      [12:0] addr,
+	input      [ 3:0] wstrb,
+	input      [31:0] wdata,
+	output reg [31:0] rdata
+);
+	localparam [2:0] OP_NTT    = 1;
+	localparam [2:0] OP_INVNTT = 2;
+	localparam [2:0] OP_MUL    = 3;
+	localparam [2:0] OP_MAC    = 4;
+	localparam [2:0] OP_REDUCE = 5;
+
+	reg dilithium;
+
+	wire signed [31:0] q      = dilithium ? 8380417  : 3329;
+	wire        [31:0] qinv   = dilithium ? 58728449 : 62209;   // q^-1 mod 2^32 or 2^16
+	wire signed [31:0] mont_f = dilithium ? 41978    : 1441;    // mont^2/256 or mont^2/128
+	wire        [ 2:0] lg_min = dilithium ? 0 : 1;
+
+	// results are 32-bit (Dilithium) or sign extended 16-bit (Kyber) values
+	function [31:0] wrap;
+		input [31:0] value;
+		input dil;
+		wrap = dil ? value : {{16{value[15]}}, value[15:0]};
+	endfunction
+
+
+	// State
+
+	reg busy, acc;
+	reg [2:0] op;
+	reg [1:0] sel;
+	reg phase;
+	reg [2:0] lg;
+	reg [7:0] idx;
+	reg [3:0] step;
+
+	reg [31:0] ra, rb, rc0, rc1, zeta;
+	reg [31:0] a0, a1, b0, b1, m3, m4;
+
+	wire do_ct       = op == OP_NTT;
+	wire do_gs       = op == OP_INVNTT && !phase;
+	wire do_scale    = op == OP_INVNTT && phase;
+	wire do_basemul  = (op == OP_MUL || op == OP_MAC) && !dilithium;
+	wire do_pointwise = (op == OP_MUL || op == OP_MAC) && dilithium;
+	wire do_reduce   = op == OP_REDUCE;
+	wire do_mac      = op == OP_MAC;
+
+	// butterfly idx of layer lg (len = 2^lg) works on j and j + len
+	wire [7:0] lg_mask = (8'd1 << lg) - 1;
+	wire [7:0] group = {1'b0, idx[6:0]} >> lg;
+	wire [7:0] bf_j = (group << (lg + 1)) | (idx & lg_mask);
+	wire [7:0] bf_jl = bf_j | (8'd1 << lg);
+	wire [7:0] zeta_fwd = (8'd128 >> lg) + group;
+	wire [8:0] zeta_inv = (9'd256 >> lg) - 1 - group;
+
+	reg [3:0] last_step;
+	reg [7:0] last_idx;
+
+	always @* begin
+		last_step = 'bx;
+		last_idx = 255;
+		(* parallel_case *)
+		case (1'b1)
+			do_ct:        begin last_step = 6;  last_idx = 127; end
+			do_gs:        begin last_step = 6;  last_idx = 127; end
+			do_scale:     begin last_step = 4;  end
+			do_basemul:   begin last_step = 10; last_idx = 127; end
+			do_pointwise: begin last_step = 5;  end
+			do_reduce:    begin last_step = 1;  end
+		endcase
+	end
+
+
+	// Coefficient and twiddle factor RAM
+
+	reg [31:0] ram [0:767];
+	reg [31:0] zram [0:255];
+
+	reg [9:0] ram_addr;
+	reg ram_we;
+	reg [31:0] ram_wdata;
+	reg [31:0] ram_rdata;
+
+	reg [7:0] zram_addr;
+	reg zram_we;
+	reg [31:0] zram_rdata;
+
+	always @(posedge clk) begin
+		if (ram_we)
+			ram[ram_addr] <= ram_wdata;
+		ram_rdata <= ram[ram_addr];
+		if (zram_we)
+			zram[zram_addr] <= wdata;
+		zram_rdata <= zram[zram_addr];
+	end
+
+
+	// Montgomery multiplier and reduction
+
+	reg signed [31:0] mul_a, mul_b;
+	reg signed [63:0] p, pp;
+	reg signed [31:0] t;
+	reg [31:0] mr;
+
+	wire [31:0] p_qinv = p[31:0] * qinv;
+	wire signed [63:0] mont_d = pp - t * q;
+
+	always @(posedge clk) begin
+		p <= mul_a * mul_b;
+		pp <= p;
+		t <= dilithium ? p_qinv : {{16{p_qinv[15]}}, p_qinv[15:0]};
+		mr <= wrap(dilithium ? mont_d[63:32] : mont_d[47:16], dilithium);
+	end
+
+	// barrett_reduce() for Kyber, reduce32() for Dilithium
+	reg [31:0] red_in;
+	wire signed [31:0] red_x = wrap(red_in, dilithium);
+	wire signed [31:0] red_t = dilithium ? (red_x + (1 << 22)) >>> 23 : (red_x * 20159 + (1 << 25)) >>> 26;
+	wire [31:0] red_out = wrap(red_x - red_t * q, dilithium);
+
+
+	// Datapath control
+
+	always @* begin
+		ram_addr = addr[11:2];
+		ram_we = !busy && valid && !ready && !addr[12] && addr[11:10] != 3 && |wstrb;
+		ram_wdata = wdata;
+		zram_addr = addr[9:2];
+		zram_we = !busy && valid && !ready && !addr[12] && addr[11:10] == 3 && |wstrb;
+		mul_a = 'bx;
+		mul_b = 'bx;
+		red_in = 'bx;
+
+		if (busy) begin
+			(* parallel_case *)
+			case (1'b1)
+				do_ct: begin
+					case (step)
+						0: begin ram_addr = {sel, bf_j}; zram_addr = zeta_fwd; end
+						1: ram_addr = {sel, bf_jl};
+						2: begin mul_a = zeta; mul_b = ram_rdata; end
+						5: begin ram_addr = {sel, bf_j}; ram_we = 1; ram_wdata = wrap(ra + mr, dilithium); end
+						6: begin ram_addr = {sel, bf_jl}; ram_we = 1; ram_wdata = rb; end
+					endcase
+				end
+				do_gs: begin
+					case (step)
+						0: begin ram_addr = {sel, bf_j}; zram_addr = zeta_inv; end
+						1: ram_addr = {sel, bf_jl};
+						3: begin
+							ram_addr = {sel, bf_j};
+							ram_we = 1;
+							red_in = ra + rb;
+							ram_wdata = dilithium ? ra + rb : red_out;
+							mul_a = zeta;
+							mul_b = dilithium ? ra - rb : wrap(rb - ra, 0);
+						end
+						6: begin ram_addr = {sel, bf_jl}; ram_we = 1; ram_wdata = mr; end
+					endcase
+				end
+				do_scale: begin
+					case (step)
+						0: ram_addr = {sel, idx};
+						1: begin mul_a = mont_f; mul_b = ram_rdata; end
+						4: begin ram_addr = {sel, idx}; ram_we = 1; ram_wdata = mr; end
+					endcase
+				end
+				do_basemul: begin
+					case (step)
+						0: begin ram_addr = {2'd0, idx[6:0], 1'b0}; zram_addr = 64 + idx[6:1]; end
+						1: ram_addr = {2'd0, idx[6:0], 1'b1};
+						2: ram_addr = {2'd1, idx[6:0], 1'b0};
+						3: begin ram_addr = {2'd1, idx[6:0], 1'b1}; mul_a = a0; mul_b = ram_rdata; end
+						4: begin ram_addr = {2'd2, idx[6:0], 1'b0}; mul_a = a1; mul_b = ram_rdata; end
+						5: begin ram_addr = {2'd2, idx[6:0], 1'b1}; mul_a = a0; mul_b = b1; end
+						6: begin mul_a = a1; mul_b = b0; end
+						7: begin mul_a = mr; mul_b = zeta; end
+						9: begin
+							ram_addr = {2'd2, idx[6:0], 1'b1};
+							ram_we = 1;
+							ram_wdata = wrap(m4 + mr + (do_mac ? rc1 : 0), 0);
+						end
+						10: begin
+							ram_addr = {2'd2, idx[6:0], 1'b0};
+							ram_we = 1;
+							ram_wdata = wrap(m3 + mr + (do_mac ? rc0 : 0), 0);
+						end
+					endcase
+				end
+				do_pointwise: begin
+					case (step)
+						0: ram_addr = {2'd0, idx};
+						1: ram_addr = {2'd1, idx};
+						2: begin ram_addr = {2'd2, idx}; mul_a = ra; mul_b = ram_rdata; end
+						5: begin ram_addr = {2'd2, idx}; ram_we = 1; ram_wdata = mr + (do_mac ? rc0 : 0); end
+					endcase
+				end
+				do_reduce: begin
+					case (step)
+						0: ram_addr = {sel, idx};
+						1: begin ram_addr = {sel, idx}; ram_we = 1; red_in = ram_rdata; ram_wdata = red_out; end
+					endcase
+				end
+			endcase
+		end
+	end
+
+	always @(posedge clk) begin
+		ready <= 0;
+		if (!resetn) begin
+			busy <= 0;
+			acc <= 0;
+			dilithium <= 0;
+		end else
+		if (busy) begin
+			(* parallel_case *)
+			case (1'b1)
+				do_ct: begin
+					if (step == 1) begin ra <= ram_rdata; zeta <= zram_rdata; end
+					if (step == 5) rb <= wrap(ra - mr, dilithium);
+				end
+				do_gs: begin
+					if (step == 1) begin ra <= ram_rdata; zeta <= wrap(dilithium ? -zram_rdata : zram_rdata, dilithium); end
+					if (step == 2) rb <= ram_rdata;
+				end
+				do_basemul: begin
+					if (step == 1) begin a0 <= ram_rdata; zeta <= wrap(idx[0] ? -zram_rdata : zram_rdata, 0); end
+					if (step == 2) a1 <= ram_rdata;
+					if (step == 3) b0 <= ram_rdata;
+					if (step == 4) b1 <= ram_rdata;
+					if (step == 5) rc0 <= ram_rdata;
+					if (step == 6) begin rc1 <= ram_rdata; m3 <= mr; end
+					if (step == 8) m4 <= mr;
+				end
+				do_pointwise: begin
+					if (step == 1) ra <= ram_rdata;
+					if (step == 3) rc0 <= ram_rdata;
+				end
+			endcase
+
+			step <= step + 1;
+			if (step == last_step) begin
+				step <= 0;
+				idx <= idx + 1;
+				if (idx == last_idx) begin
+					idx <= 0;
+					(* parallel_case *)
+					case (1'b1)
+						do_ct: begin
+							if (lg == lg_min)
+								busy <= 0;
+							lg <= lg - 1;
+						end
+						do_gs: begin
+							if (lg == 7)
+								phase <= 1;
+							lg <= lg + 1;
+						end
+						default:
+							busy <= 0;
+					endcase
+				end
+			end
+		end else
+		if (valid && !ready) begin
+			if (addr[12]) begin
+				ready <= 1;
+				rdata <= addr[2] ? {31'b0, dilithium} : 0;
+				if (|wstrb) begin
+					if (addr[2]) begin
+						dilithium <= wdata[0];
+					end else
+					if (wdata[2:0] >= OP_NTT && wdata[2:0] <= OP_REDUCE && wdata[5:4] != 3) begin
+						busy <= 1;
+						op <= wdata[2:0];
+						sel <= wdata[5:4];
+						phase <= 0;
+						lg <= wdata[2:0] == OP_NTT ? 3'd7 : lg_min;
+						idx <= 0;
+						step <= 0;
+					end
+				end
+			end else
+			if (|wstrb) begin
+				ready <= 1;
+			end else
+			if (!acc) begin
+				acc <= 1;
+			end else begin
+				acc <= 0;
+				ready <= 1;
+				rdata <= addr[11:10] == 3 ? zram_rdata : ram_rdata;
+			end
+		end
+	end
+endmodule
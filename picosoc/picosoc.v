@@ -76,6 +76,11 @@ module picosoc (
 	parameter [0:0] ENABLE_COMPRESSED = 1;
 	parameter [0:0] ENABLE_COUNTERS = 1;
 	parameter [0:0] ENABLE_IRQ_QREGS = 0;
+	parameter integer ICACHE_WORDS = 0;
+	parameter integer TCM_WORDS = 0;
+	parameter [31:0] TCM_ADDR = 32'h 0400_0000;
+	parameter [0:0] ENABLE_NTT_ENGINE = 0;
+	parameter [31:0] NTT_ENGINE_ADDR = 32'h 0300_2000;
 
 	parameter integer MEM_WORDS = 256;
 	parameter [31:0] STACKADDR = (4*MEM_WORDS);       // end of memory
@@ -95,6 +100,15 @@ module picosoc (
 		irq[7] = irq_7;
 	end
 
+	wire cpu_mem_valid;
+	wire cpu_mem_instr;
+	wire cpu_mem_ready;
+	wire [31:0] cpu_mem_addr;
+	wire [31:0] cpu_mem_wdata;
+	wire [3:0] cpu_mem_wstrb;
+	wire [31:0] cpu_mem_rdata;
+	wire [31:0] cpu_mem_la_addr;
+
 	wire mem_valid;
 	wire mem_instr;
 	wire mem_ready;
@@ -103,13 +117,56 @@ module picosoc (
 	wire [3:0] mem_wstrb;
 	wire [31:0] mem_rdata;
 
+	wire [31:0] icache_hits;
+	wire [31:0] icache_misses;
+
+	generate if (ICACHE_WORDS) begin
+		picorv32_icache #(
+			.WORDS(ICACHE_WORDS)
+		) icache (
+			.clk          (clk            ),
+			.resetn       (resetn         ),
+			.mem_valid    (cpu_mem_valid  ),
+			.mem_instr    (cpu_mem_instr  ),
+			.mem_ready    (cpu_mem_ready  ),
+			.mem_addr     (cpu_mem_addr   ),
+			.mem_wdata    (cpu_mem_wdata  ),
+			.mem_wstrb    (cpu_mem_wstrb  ),
+			.mem_rdata    (cpu_mem_rdata  ),
+			.mem_la_addr  (cpu_mem_la_addr),
+			.bus_valid    (mem_valid      ),
+			.bus_instr    (mem_instr      ),
+			.bus_ready    (mem_ready      ),
+			.bus_addr     (mem_addr       ),
+			.bus_wdata    (mem_wdata      ),
+			.bus_wstrb    (mem_wstrb      ),
+			.bus_rdata    (mem_rdata      ),
+			.icache_hits  (icache_hits    ),
+			.icache_misses(icache_misses  )
+		);
+	end else begin
+		assign mem_valid = cpu_mem_valid;
+		assign mem_instr = cpu_mem_instr;
+		assign mem_addr = cpu_mem_addr;
+		assign mem_wdata = cpu_mem_wdata;
+		assign mem_wstrb = cpu_mem_wstrb;
+		assign cpu_mem_ready = mem_ready;
+		assign cpu_mem_rdata = mem_rdata;
+		assign icache_hits = 0;
+		assign icache_misses = 0;
+	end endgenerate
+
 	wire spimem_ready;
 	wire [31:0] spimem_rdata;
 
 	reg ram_ready;
 	wire [31:0] ram_rdata;
 
-	assign iomem_valid = mem_valid && (mem_addr[31:24] > 8'h 01);
+	wire ntt_engine_sel = ENABLE_NTT_ENGINE && mem_valid && (mem_addr[31:13] == NTT_ENGINE_ADDR[31:13]);
+	wire ntt_engine_ready;
+	wire [31:0] ntt_engine_rdata;
+
+	assign iomem_valid = mem_valid && (mem_addr[31:24] > 8'h 01) && !ntt_engine_sel;
 	assign iomem_wstrb = mem_wstrb;
 	assign iomem_addr = mem_addr;
 	assign iomem_wdata = mem_wdata;
@@ -124,12 +181,17 @@ module picosoc (
 	wire [31:0] simpleuart_reg_dat_do;
 	wire        simpleuart_reg_dat_wait;
 
+	wire        icache_hits_sel = mem_valid && (mem_addr == 32'h 0200_000c);
+	wire        icache_misses_sel = mem_valid && (mem_addr == 32'h 0200_0010);
+
 	assign mem_ready = (iomem_valid && iomem_ready) || spimem_ready || ram_ready || spimemio_cfgreg_sel ||
-			simpleuart_reg_div_sel || (simpleuart_reg_dat_sel && !simpleuart_reg_dat_wait);
+			simpleuart_reg_div_sel || (simpleuart_reg_dat_sel && !simpleuart_reg_dat_wait) ||
+			icache_hits_sel || icache_misses_sel || ntt_engine_ready;
 
 	assign mem_rdata = (iomem_valid && iomem_ready) ? iomem_rdata : spimem_ready ? spimem_rdata : ram_ready ? ram_rdata :
 			spimemio_cfgreg_sel ? spimemio_cfgreg_do : simpleuart_reg_div_sel ? simpleuart_reg_div_do :
-			simpleuart_reg_dat_sel ? simpleuart_reg_dat_do : 32'h 0000_0000;
+			simpleuart_reg_dat_sel ? simpleuart_reg_dat_do : icache_hits_sel ? icache_hits :
+			icache_misses_sel ? icache_misses : ntt_engine_ready ? ntt_engine_rdata : 32'h 0000_0000;
 
 	picorv32 #(
 		.STACKADDR(STACKADDR),
@@ -142,18 +204,21 @@ module picosoc (
 		.ENABLE_DIV(ENABLE_DIV),
 		.ENABLE_FAST_MUL(ENABLE_FAST_MUL),
 		.ENABLE_IRQ(1),
-		.ENABLE_IRQ_QREGS(ENABLE_IRQ_QREGS)
+		.ENABLE_IRQ_QREGS(ENABLE_IRQ_QREGS),
+		.TCM_WORDS(TCM_WORDS),
+		.TCM_ADDR(TCM_ADDR)
 	) cpu (
-		.clk         (clk        ),
-		.resetn      (resetn     ),
-		.mem_valid   (mem_valid  ),
-		.mem_instr   (mem_instr  ),
-		.mem_ready   (mem_ready  ),
-		.mem_addr    (mem_addr   ),
-		.mem_wdata   (mem_wdata  ),
-		.mem_wstrb   (mem_wstrb  ),
-		.mem_rdata   (mem_rdata  ),
-		.irq         (irq        )
+		.clk         (clk            ),
+		.resetn      (resetn         ),
+		.mem_valid   (cpu_mem_valid  ),
+		.mem_instr   (cpu_mem_instr  ),
+		.mem_ready   (cpu_mem_ready  ),
+		.mem_addr    (cpu_mem_addr   ),
+		.mem_wdata   (cpu_mem_wdata  ),
+		.mem_wstrb   (cpu_mem_wstrb  ),
+		.mem_rdata   (cpu_mem_rdata  ),
+		.mem_la_addr (cpu_mem_la_addr),
+		.irq         (irq            )
 	);
 
 	spimemio spimemio (
@@ -205,6 +270,22 @@ module picosoc (
 		.reg_dat_wait(simpleuart_reg_dat_wait)
 	);
 
+	generate if (ENABLE_NTT_ENGINE) begin
+		ntt_engine ntt_engine (
+			.clk   (clk             ),
+			.resetn(resetn          ),
+			.valid (ntt_engine_sel  ),
+			.ready (ntt_engine_ready),
+			.addr  (mem_addr[12:0]  ),
+			.wstrb (mem_wstrb       ),
+			.wdata (mem_wdata       ),
+			.rdata (ntt_engine_rdata)
+		);
+	end else begin
+		assign ntt_engine_ready = 0;
+		assign ntt_engine_rdata = 0;
+	end endgenerate
+
 	always @(posedge clk)
 		ram_ready <= mem_valid && !mem_ready && mem_addr < 4*MEM_WORDS;
 
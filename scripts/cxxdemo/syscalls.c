@@ -75,13 +75,27 @@ int _fstat(int file, struct stat *st)
 	return -1;
 }
 
+// Copy the .tcm load image (placed at _end by riscv.ld) to the
+// tightly-coupled memory of the core, before any other constructor runs
+extern unsigned int _tcm_load[], _tcm_start[], _tcm_end[];   // Defined by linker
+
+__attribute__((constructor(101)))
+static void tcm_init(void)
+{
+	unsigned int *src = _tcm_load;
+
+	for (unsigned int *dst = _tcm_start; dst != _tcm_end; dst++)
+		*dst = *(src++);
+}
+
 void *_sbrk(ptrdiff_t incr)
 {
 	extern unsigned char _end[];   // Defined by linker
 	static unsigned long heap_end;
 
+	// the heap starts after the .tcm load image
 	if (heap_end == 0)
-		heap_end = (long)_end;
+		heap_end = (long)_end + ((long)_tcm_end - (long)_tcm_start);
 
 	heap_end += incr;
 	return (void *)(heap_end - incr);
@@ -23,19 +23,69 @@ module testbench;
 	wire [3:0] mem_wstrb;
 	reg  [31:0] mem_rdata;
 
+	wire keccak_sel = mem_valid && mem_addr[31:8] == 24'h 0300_10;
+	wire keccak_ready;
+	wire [31:0] keccak_rdata;
+
+	wire ntt_sel = mem_valid && mem_addr[31:13] == 32'h 0300_2000 >> 13;
+	wire ntt_ready;
+	wire [31:0] ntt_rdata;
+
 	picorv32 #(
-		.COMPRESSED_ISA(1)
+		.COMPRESSED_ISA(1),
+		.ENABLE_KYBER_NTT(1),
+		.ENABLE_KYBER_MONT(1),
+		.ENABLE_REGS_RS3(1),
+		.ENABLE_KYBER_CBD(1),
+		.ENABLE_REJ_UNIFORM(1),
+		.ENABLE_KYBER_COMPRESS(1),
+		.ENABLE_DILITHIUM_MONT(1),
+		.ENABLE_DILITHIUM_ROUND(1),
+		.ENABLE_GFMUL12(1),
+		.ENABLE_AES32(1),
+		.ENABLE_ZBKB(1),
+		.ENABLE_ZBP(1),
+		.ENABLE_FAST_CLMUL(1),
+		.ENABLE_SIMD16(1),
+		.ENABLE_ZKNH(1),
+		.ENABLE_HWLOOP(1),
+		.ENABLE_PIPELINE(1),
+		.ENABLE_BTFN(1),
+		.TCM_WORDS(4096),
+		.HPM_EVENTS(32'h 0000_003f)
 	) uut (
 		.clk         (clk        ),
 		.resetn      (resetn     ),
 		.trap        (trap       ),
 		.mem_valid   (mem_valid  ),
 		.mem_instr   (mem_instr  ),
-		.mem_ready   (mem_ready  ),
+		.mem_ready   (mem_ready || keccak_ready || ntt_ready),
 		.mem_addr    (mem_addr   ),
 		.mem_wdata   (mem_wdata  ),
 		.mem_wstrb   (mem_wstrb  ),
-		.mem_rdata   (mem_rdata  )
+		.mem_rdata   (keccak_ready ? keccak_rdata : ntt_ready ? ntt_rdata : mem_rdata)
+	);
+
+	keccakf1600 keccak (
+		.clk    (clk         ),
+		.resetn (resetn      ),
+		.valid  (keccak_sel  ),
+		.ready  (keccak_ready),
+		.addr   (mem_addr[7:0]),
+		.wstrb  (mem_wstrb   ),
+		.wdata  (mem_wdata   ),
+		.rdata  (keccak_rdata)
+	);
+
+	ntt_engine ntt (
+		.clk    (clk          ),
+		.resetn (resetn       ),
+		.valid  (ntt_sel      ),
+		.ready  (ntt_ready    ),
+		.addr   (mem_addr[12:0]),
+		.wstrb  (mem_wstrb    ),
+		.wdata  (mem_wdata    ),
+		.rdata  (ntt_rdata    )
 	);
 
 	localparam MEM_SIZE = 4*1024*1024;
@@ -49,7 +99,7 @@ module testbench;
 
 	always @(posedge clk) begin
 		mem_ready <= 0;
-		if (mem_valid && !mem_ready) begin
+		if (mem_valid && !mem_ready && !keccak_sel && !ntt_sel) begin
 			mem_ready <= 1;
 			mem_rdata <= 'bx;
 			case (1)
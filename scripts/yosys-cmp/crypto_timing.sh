@@ -0,0 +1,52 @@
+#!/bin/bash
+#
+# Compare the critical path of the core with each of the cryptography options
+# enabled on its own. The logic depth is the longest path between flip-flops
+# in iCE40 cells (LUTs and carry cells), as reported by "ltp -noff" after
+# synth_ice40.
+#
+# Usage: bash crypto_timing.sh [baseline.v]
+#
+# baseline.v is an optional older picorv32.v to compare against, e.g. one
+# with the combinational instr_kyber in the main FSM:
+#
+#   git show <rev>:picorv32.v > baseline.v
+#
+
+set -e
+
+baseline="${1:+$(readlink -f "$1")}"
+
+rm -rf crypto_timing.tmp
+mkdir crypto_timing.tmp
+cd crypto_timing.tmp
+
+run() {
+	name="$1"
+	src="$2"
+	shift 2
+	yosys -q -l "$name.log" -p "read_verilog $src; $*; synth_ice40 -top picorv32; ltp -noff; stat" > /dev/null
+	depth=$(sed -n 's/^Longest topological path in .* (length=\([0-9]*\)).*/\1/p' "$name.log" | tail -n 1)
+	luts=$(awk '/SB_LUT4/ { for (i = 1; i <= NF; i++) if ($i ~ /^[0-9]+$/) n = $i } END { print n }' "$name.log")
+	printf "%-28s %8s %8s\n" "$name" "$depth" "$luts"
+}
+
+printf "%-28s %8s %8s\n" "configuration" "depth" "SB_LUT4"
+
+if [ -n "$baseline" ]; then
+	run baseline "$baseline"
+fi
+
+run default ../../../picorv32.v
+
+# PCPI cores
+run kyber_mont ../../../picorv32.v "chparam -set ENABLE_KYBER_MONT 1 picorv32"
+run kyber_mont_extra_ffs ../../../picorv32.v "chparam -set ENABLE_KYBER_MONT 1 picorv32; chparam -set EXTRA_MUL_FFS 1 -set EXTRA_INSN_FFS 1 picorv32_pcpi_kyber"
+run dilithium_mont ../../../picorv32.v "chparam -set ENABLE_DILITHIUM_MONT 1 picorv32"
+run clmul ../../../picorv32.v "chparam -set ENABLE_CLMUL 1 picorv32"
+run fast_clmul ../../../picorv32.v "chparam -set ENABLE_FAST_CLMUL 1 picorv32"
+
+# instructions executed in the ALU of the core
+for param in KYBER_NTT KYBER_CBD REJ_UNIFORM KYBER_COMPRESS DILITHIUM_ROUND GFMUL12 AES32 ZBKB ZBP SIMD16 ZKNH; do
+	run "$(echo $param | tr A-Z a-z)" ../../../picorv32.v "chparam -set ENABLE_$param 1 picorv32"
+done
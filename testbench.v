@@ -160,18 +160,109 @@ module picorv32_wrapper #(
 	wire [31:0] rvfi_mem_wdata;
 `endif
 
+	wire        pcpi_valid;
+	wire [31:0] pcpi_insn;
+	wire [31:0] pcpi_rs1;
+	wire [31:0] pcpi_rs2;
+	wire [31:0] pcpi_rs3;
+	wire        pcpi_wr;
+	wire [31:0] pcpi_rd;
+	wire        pcpi_wait;
+	wire        pcpi_ready;
+
+`ifdef CUSTOM_TEST
+	wire [ 1:0] slot_valid;
+	wire [31:0] slot_insn;
+	wire [31:0] slot_rs1;
+	wire [31:0] slot_rs2;
+	wire [31:0] slot_rs3;
+	wire [ 1:0] slot_wr;
+	wire [63:0] slot_rd;
+	wire [ 1:0] slot_ready;
+
+	// slot 0 is custom-0 and slot 1 is custom-1, both with funct3 = 0
+	picorv32_pcpi_custom #(
+		.SLOTS(2),
+		.SLOT_MATCH({32'h 0000_002b, 32'h 0000_000b})
+	) pcpi_custom (
+		.clk       (clk       ),
+		.resetn    (resetn    ),
+		.pcpi_valid(pcpi_valid),
+		.pcpi_insn (pcpi_insn ),
+		.pcpi_rs1  (pcpi_rs1  ),
+		.pcpi_rs2  (pcpi_rs2  ),
+		.pcpi_rs3  (pcpi_rs3  ),
+		.pcpi_wr   (pcpi_wr   ),
+		.pcpi_rd   (pcpi_rd   ),
+		.pcpi_wait (pcpi_wait ),
+		.pcpi_ready(pcpi_ready),
+		.slot_valid(slot_valid),
+		.slot_insn (slot_insn ),
+		.slot_rs1  (slot_rs1  ),
+		.slot_rs2  (slot_rs2  ),
+		.slot_rs3  (slot_rs3  ),
+		.slot_wr   (slot_wr   ),
+		.slot_rd   (slot_rd   ),
+		.slot_ready(slot_ready)
+	);
+
+	custom_slot slot0 (
+		.clk   (clk          ),
+		.resetn(resetn       ),
+		.valid (slot_valid[0]),
+		.insn  (slot_insn    ),
+		.rs1   (slot_rs1     ),
+		.rs2   (slot_rs2     ),
+		.rs3   (slot_rs3     ),
+		.wr    (slot_wr[0]   ),
+		.rd    (slot_rd[31:0]),
+		.ready (slot_ready[0])
+	);
+
+	custom_slot slot1 (
+		.clk   (clk           ),
+		.resetn(resetn        ),
+		.valid (slot_valid[1] ),
+		.insn  (slot_insn     ),
+		.rs1   (slot_rs1      ),
+		.rs2   (slot_rs2      ),
+		.rs3   (slot_rs3      ),
+		.wr    (slot_wr[1]    ),
+		.rd    (slot_rd[63:32]),
+		.ready (slot_ready[1] )
+	);
+`else
+	assign pcpi_wr = 0;
+	assign pcpi_rd = 0;
+	assign pcpi_wait = 0;
+	assign pcpi_ready = 0;
+`endif
+
 	picorv32_axi #(
 `ifndef SYNTH_TEST
 `ifdef SP_TEST
 		.ENABLE_REGS_DUALPORT(0),
 `endif
+`ifdef ICACHE_TEST
+		.ICACHE_WORDS(256),
+`endif
+`ifdef PIPELINE_TEST
+		.ENABLE_PIPELINE(1),
+		.ENABLE_BTFN(1),
+`endif
+`ifdef CUSTOM_TEST
+		.ENABLE_PCPI(1),
+		.ENABLE_REGS_RS3(1),
+`endif
 `ifdef COMPRESSED_ISA
 		.COMPRESSED_ISA(1),
 `endif
 		.ENABLE_MUL(1),
 		.ENABLE_DIV(1),
 		.ENABLE_IRQ(1),
-		.ENABLE_TRACE(1)
+		.ENABLE_TRACE(1),
+		.ENABLE_AES32(1),
+		.ENABLE_ZBKB(1)
 `endif
 	) uut (
 		.clk            (clk            ),
@@ -194,6 +285,15 @@ module picorv32_wrapper #(
 		.mem_axi_rvalid (mem_axi_rvalid ),
 		.mem_axi_rready (mem_axi_rready ),
 		.mem_axi_rdata  (mem_axi_rdata  ),
+		.pcpi_valid     (pcpi_valid     ),
+		.pcpi_insn      (pcpi_insn      ),
+		.pcpi_rs1       (pcpi_rs1       ),
+		.pcpi_rs2       (pcpi_rs2       ),
+		.pcpi_rs3       (pcpi_rs3       ),
+		.pcpi_wr        (pcpi_wr        ),
+		.pcpi_rd        (pcpi_rd        ),
+		.pcpi_wait      (pcpi_wait      ),
+		.pcpi_ready     (pcpi_ready     ),
 		.irq            (irq            ),
 `ifdef RISCV_FORMAL
 		.rvfi_valid     (rvfi_valid     ),
@@ -261,6 +361,9 @@ module picorv32_wrapper #(
 			repeat (10) @(posedge clk);
 `endif
 			$display("TRAP after %1d clock cycles", cycle_counter);
+`ifdef ICACHE_TEST
+			$display("ICACHE: %1d hits, %1d misses", uut.icache_hits, uut.icache_misses);
+`endif
 			if (tests_passed) begin
 				$display("ALL TESTS PASSED.");
 				$finish;
@@ -274,6 +377,38 @@ module picorv32_wrapper #(
 	end
 endmodule
 
+`ifdef CUSTOM_TEST
+// Accelerator slot for test_custom: returns (rs1 ^ rs2) + rs3 after
+// insn[26:25] + 1 cycles (the funct2 field of an R4-type instruction)
+module custom_slot (
+	input clk, resetn,
+	input             valid,
+	input      [31:0] insn,
+	input      [31:0] rs1,
+	input      [31:0] rs2,
+	input      [31:0] rs3,
+	output reg        wr,
+	output reg [31:0] rd,
+	output reg        ready
+);
+	reg [1:0] count;
+
+	always @(posedge clk) begin
+		wr <= 0;
+		ready <= 0;
+		count <= 0;
+		if (resetn && valid && !ready) begin
+			count <= count + 1;
+			if (count == insn[26:25]) begin
+				wr <= 1;
+				rd <= (rs1 ^ rs2) + rs3;
+				ready <= 1;
+			end
+		end
+	end
+endmodule
+`endif
+
 module axi4_memory #(
 	parameter AXI_TEST = 0,
 	parameter VERBOSE = 0
@@ -0,0 +1,141 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+`timescale 1 ns / 1 ps
+
+// Exhaustive test of the Dilithium3 rounding datapath (make
+// test_dilithium_round). decompose, power2round and use_hint are checked for
+// all 0 <= a < Q, make_hint for all |a0| <= 600000 with a1 = 0 and a1 != 0.
+// The results are compared against rounding.c of the PQClean reference code
+// in firmware/dilithium3/clean/rounding.c.
+
+module testbench;
+	reg clk = 1;
+	reg resetn = 0;
+
+	localparam integer Q = 8380417;
+	localparam integer GAMMA2 = (Q - 1) / 32;
+
+	picorv32 #(
+		.ENABLE_DILITHIUM_ROUND(1)
+	) uut (
+		.clk       (clk   ),
+		.resetn    (resetn),
+		.mem_ready (1'b0  ),
+		.mem_rdata (32'b0 ),
+		.pcpi_wr   (1'b0  ),
+		.pcpi_rd   (32'b0 ),
+		.pcpi_wait (1'b0  ),
+		.pcpi_ready(1'b0  ),
+		.irq       (32'b0 )
+	);
+
+	// decompose(), packed like the dilithium_decompose result
+	function [31:0] ref_decompose;
+		input integer a;
+		integer a0, a1;
+		begin
+			a1 = (a + 127) >>> 7;
+			a1 = (a1 * 1025 + (1 << 21)) >>> 22;
+			a1 = a1 & 15;
+
+			a0 = a - a1 * 2 * GAMMA2;
+			a0 = a0 - ((((Q - 1) / 2 - a0) >>> 31) & Q);
+			ref_decompose = {a1[3:0], a0[27:0]};
+		end
+	endfunction
+
+	// power2round(), packed like the dilithium_power2round result
+	function [31:0] ref_power2round;
+		input integer a;
+		integer a0, a1;
+		begin
+			a1 = (a + (1 << 12) - 1) >>> 13;
+			a0 = a - (a1 << 13);
+			ref_power2round = {a1[9:0], a0[21:0]};
+		end
+	endfunction
+
+	function [31:0] ref_make_hint;
+		input integer a0, a1;
+		ref_make_hint = a0 > GAMMA2 || a0 < -GAMMA2 || (a0 == -GAMMA2 && a1 != 0);
+	endfunction
+
+	function [31:0] ref_use_hint;
+		input integer a, hint;
+		integer a0, a1;
+		begin
+			a1 = ref_decompose(a) >> 28;
+			a0 = $signed(ref_decompose(a) << 4) >>> 4;
+			if (hint == 0)
+				ref_use_hint = a1;
+			else if (a0 > 0)
+				ref_use_hint = (a1 + 1) & 15;
+			else
+				ref_use_hint = (a1 - 1) & 15;
+		end
+	endfunction
+
+	integer a, errors;
+
+	task check;
+		input [8*16-1:0] name;
+		input integer op1, op2;
+		input [31:0] expected;
+		begin
+			uut.reg_op1 = op1;
+			uut.reg_op2 = op2;
+			#1;
+			if (uut.dilithium_round_out !== expected) begin
+				if (errors < 10)
+					$display("ERROR: %0s(%1d, %1d) = %08x, expected %08x", name, op1, op2, uut.dilithium_round_out, expected);
+				errors = errors + 1;
+			end
+		end
+	endtask
+
+	task select;
+		input [3:0] insn;
+		begin
+			uut.instr_dilithium_decompose = insn[0];
+			uut.instr_dilithium_power2round = insn[1];
+			uut.instr_dilithium_make_hint = insn[2];
+			uut.instr_dilithium_use_hint = insn[3];
+		end
+	endtask
+
+	initial begin
+		errors = 0;
+
+		select(4'b0001);
+		for (a = 0; a < Q; a = a+1)
+			check("decompose", a, 32'h 5a5a5a5a, ref_decompose(a));
+
+		select(4'b0010);
+		for (a = 0; a < Q; a = a+1)
+			check("power2round", a, 32'h 5a5a5a5a, ref_power2round(a));
+
+		select(4'b1000);
+		for (a = 0; a < Q; a = a+1) begin
+			check("use_hint", a, 0, ref_use_hint(a, 0));
+			check("use_hint", a, 1, ref_use_hint(a, 1));
+		end
+
+		select(4'b0100);
+		for (a = -600000; a <= 600000; a = a+1) begin
+			check("make_hint", a, 0, ref_make_hint(a, 0));
+			check("make_hint", a, 5, ref_make_hint(a, 5));
+		end
+
+		if (errors) begin
+			$display("%1d ERRORS.", errors);
+			$stop;
+		end
+		$display("ALL TESTS PASSED.");
+		$finish;
+	end
+endmodule
@@ -0,0 +1,166 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+`timescale 1 ns / 1 ps
+
+// Test of the Keccak-f[1600] engine in picosoc/keccakf1600.v (make
+// test_keccak). The engine is driven through its memory interface and the
+// permuted states are compared against KeccakF1600_StatePermute() of
+// firmware/common/fips202.c. The expected states below were computed with
+// that function. Lanes are listed from lane 24 down to lane 0.
+
+module testbench;
+	reg clk = 1;
+	reg resetn = 0;
+
+	always #5 clk = ~clk;
+
+	// permutation of the zero state
+	localparam [1599:0] P1 = {
+		64'h eaf1ff7b5ceca249, 64'h 75f644e97f30a13b, 64'h 16f53526e70465c2, 64'h 1841f924a2c509e4, 64'h 940c7922ae3a2614,
+		64'h 8c3ee88a1ccf32c8, 64'h b87c5a554fd00ecb, 64'h 613670957bc46611, 64'h 64befef28cc970f2, 64'h 05e5635a21d9ae61,
+		64'h 01f22f1a11a5569f, 64'h 43b831cd0347c826, 64'h 81a57c16dbcf555f, 64'h a9a6e6260d712103, 64'h eb5aa93f2317d635,
+		64'h 30935ab7d08ffc64, 64'h ad30a6f71b19059c, 64'h 8c5bda0cd6192e76, 64'h 90fee5a0a44647c4, 64'h ff97a42d7f8e6fd4,
+		64'h 8b284e056253d057, 64'h bd1547306f80494d, 64'h d598261ea65aa9ee, 64'h 84d5ccf933c0478a, 64'h f1258f7940e1dde7
+	};
+
+	// permutation of P1
+	localparam [1599:0] P2 = {
+		64'h 20d06cd26a8fbf5c, 64'h 609f4e62a44c1059, 64'h 5b3402464e1c3db6, 64'h 202a9ec5faa3cce8, 64'h 900e3129e7badd7b,
+		64'h 91a0226e649e42e9, 64'h e3b8c8ee55b7b03c, 64'h 48ead5fc5d0be774, 64'h 97ddad33d8994b40, 64'h fd5449a6bf174743,
+		64'h 7cf8a9f009831265, 64'h e00654042719dbd9, 64'h 33c43d836eafb1f5, 64'h deea66c4ba8f974f, 64'h 68ce61b6b9ce68a1,
+		64'h e4fecc0fee98b425, 64'h 1f1b9ee6f79a8759, 64'h faf4f247c3d810f7, 64'h 85773dae1275af0d, 64'h f957b9a2da65fb38,
+		64'h 4f9c4f99e5e7f156, 64'h 8a20d9b25569d094, 64'h 093d8d1270d76b6c, 64'h 6a332cd07057b56d, 64'h 2d5c954df96ecb3c
+	};
+
+	// permutation of the state with lane i = 0123456789abcdef ^ i * 9e3779b97f4a7c15
+	localparam [1599:0] P3 = {
+		64'h 6016b084cba7b118, 64'h f63347a1b5d64e4e, 64'h a7ef235c410080fb, 64'h ba95781ea617a93f, 64'h 0b81efcd498098c3,
+		64'h 3e1bf2f4ec9bd831, 64'h 9becfd49ec261944, 64'h 1105f2d56002b574, 64'h 8b1460919292e7fa, 64'h d51d8fe7c8db3963,
+		64'h 2f1b17385bfbf1f7, 64'h 28b7d1e89c2fd53a, 64'h 90037225896bdbc6, 64'h d67992dd53679a73, 64'h 8dbeb5dc131eb571,
+		64'h 5585e47790ca3ac5, 64'h 2b80b511a5da0648, 64'h 9f632388e2827959, 64'h f4d69e2ebd718a8b, 64'h f1be726d869add3a,
+		64'h ea9f97d799f6bc4d, 64'h 3102d42541a29ded, 64'h a92eb450c6bca342, 64'h 6bad0e792873bd43, 64'h db396e4e709eab56
+	};
+
+	reg         valid = 0;
+	wire        ready;
+	reg  [ 7:0] addr = 0;
+	reg  [ 3:0] wstrb = 0;
+	reg  [31:0] wdata = 0;
+	wire [31:0] rdata;
+
+	keccakf1600 uut (
+		.clk   (clk   ),
+		.resetn(resetn),
+		.valid (valid ),
+		.ready (ready ),
+		.addr  (addr  ),
+		.wstrb (wstrb ),
+		.wdata (wdata ),
+		.rdata (rdata )
+	);
+
+	task bus_write;
+		input [7:0] a;
+		input [31:0] d;
+		begin
+			valid <= 1;
+			addr <= a;
+			wstrb <= 4'b1111;
+			wdata <= d;
+			@(posedge clk);
+			#1;
+			while (!ready) begin
+				@(posedge clk);
+				#1;
+			end
+			valid <= 0;
+			wstrb <= 0;
+		end
+	endtask
+
+	task bus_read;
+		input [7:0] a;
+		output [31:0] d;
+		begin
+			valid <= 1;
+			addr <= a;
+			wstrb <= 0;
+			@(posedge clk);
+			#1;
+			while (!ready) begin
+				@(posedge clk);
+				#1;
+			end
+			d = rdata;
+			valid <= 0;
+		end
+	endtask
+
+	integer errors;
+
+	// read the state of the engine and compare it with expected
+	task check;
+		input [8*16-1:0] name;
+		input [1599:0] expected;
+		integer i;
+		reg [31:0] d;
+		begin
+			for (i = 0; i < 50; i = i+1) begin
+				bus_read(4*i, d);
+				if (d !== expected[32*i +: 32]) begin
+					if (errors < 10)
+						$display("ERROR: %0s: word %1d is %08x, expected %08x", name, i, d, expected[32*i +: 32]);
+					errors = errors + 1;
+				end
+			end
+			$display("%0s done.", name);
+		end
+	endtask
+
+	integer i;
+	reg [63:0] lane;
+
+	initial begin
+		errors = 0;
+		repeat (5) @(posedge clk);
+		resetn <= 1;
+		@(posedge clk);
+		#1;
+
+		// clear, then start
+		bus_write(8'h c8, 2);
+		bus_write(8'h c8, 1);
+		check("zero state", P1);
+
+		bus_write(8'h c8, 1);
+		check("P1", P2);
+
+		// clear and start in one write: the clear happens first
+		bus_write(8'h c8, 3);
+		check("clear and start", P1);
+
+		// absorb the pattern into the zero state in two steps to check that
+		// writes XOR into the state
+		bus_write(8'h c8, 2);
+		for (i = 0; i < 25; i = i+1) begin
+			lane = 64'h 0123456789abcdef ^ (i * 64'h 9e3779b97f4a7c15);
+			bus_write(8*i, lane[31:0] ^ 32'h a5a5a5a5);
+			bus_write(8*i + 4, lane[63:32]);
+			bus_write(8*i, 32'h a5a5a5a5);
+		end
+		bus_write(8'h c8, 1);
+		check("pattern", P3);
+
+		if (errors) begin
+			$display("%1d ERRORS.", errors);
+			$stop;
+		end
+		$display("ALL TESTS PASSED.");
+		$finish;
+	end
+endmodule
@@ -0,0 +1,327 @@
+// This is free and unencumbered software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+
+`timescale 1 ns / 1 ps
+
+// Test of the NTT engine in picosoc/ntt_engine.v (make test_ntt_engine). The
+// engine is loaded with the zetas of Kyber and Dilithium through its memory
+// interface, and the forward and inverse transforms of random polynomials are
+// compared against ntt() and invntt() of firmware/kyber512/clean/ntt.c and
+// ntt() and invntt_tomont() of firmware/dilithium3/clean/ntt.c.
+
+module testbench;
+	reg clk = 1;
+	reg resetn = 0;
+
+	always #5 clk = ~clk;
+
+	localparam integer KYBER_Q = 3329;
+	localparam integer DILITHIUM_Q = 8380417;
+
+	reg         valid = 0;
+	wire        ready;
+	reg  [12:0] addr = 0;
+	reg  [ 3:0] wstrb = 0;
+	reg  [31:0] wdata = 0;
+	wire [31:0] rdata;
+
+	ntt_engine uut (
+		.clk   (clk   ),
+		.resetn(resetn),
+		.valid (valid ),
+		.ready (ready ),
+		.addr  (addr  ),
+		.wstrb (wstrb ),
+		.wdata (wdata ),
+		.rdata (rdata )
+	);
+
+	task bus_write;
+		input [12:0] a;
+		input [31:0] d;
+		begin
+			valid <= 1;
+			addr <= a;
+			wstrb <= 4'b1111;
+			wdata <= d;
+			@(posedge clk);
+			#1;
+			while (!ready) begin
+				@(posedge clk);
+				#1;
+			end
+			valid <= 0;
+			wstrb <= 0;
+		end
+	endtask
+
+	task bus_read;
+		input [12:0] a;
+		output [31:0] d;
+		begin
+			valid <= 1;
+			addr <= a;
+			wstrb <= 0;
+			@(posedge clk);
+			#1;
+			while (!ready) begin
+				@(posedge clk);
+				#1;
+			end
+			d = rdata;
+			valid <= 0;
+		end
+	endtask
+
+
+	// Reference code
+
+	integer zetas [0:255];
+	integer r [0:255];
+
+	function integer sext16;
+		input integer x;
+		sext16 = (x << 16) >>> 16;
+	endfunction
+
+	function integer brv;
+		input integer x, bits;
+		integer i;
+		begin
+			brv = 0;
+			for (i = 0; i < bits; i = i+1)
+				brv = brv | (((x >> i) & 1) << (bits - 1 - i));
+		end
+	endfunction
+
+	// montgomery_reduce((int32_t)a * b) of Kyber
+	function integer kyber_fqmul;
+		input integer a, b;
+		integer p, t;
+		begin
+			p = sext16(a) * sext16(b);
+			t = sext16(sext16(p) * -3327);
+			kyber_fqmul = sext16((p - t * KYBER_Q) >>> 16);
+		end
+	endfunction
+
+	function integer kyber_barrett_reduce;
+		input integer a;
+		integer t;
+		begin
+			a = sext16(a);
+			t = (20159 * a + (1 << 25)) >>> 26;
+			kyber_barrett_reduce = sext16(a - t * KYBER_Q);
+		end
+	endfunction
+
+	// montgomery_multiply() of Dilithium
+	function integer dilithium_fqmul;
+		input integer a, b;
+		reg signed [63:0] p;
+		integer t;
+		begin
+			p = a * b;
+			t = p[31:0] * 58728449;
+			p = p - t * 64'sd 8380417;
+			dilithium_fqmul = p >>> 32;
+		end
+	endfunction
+
+	task kyber_zetas;
+		integer i, j, z;
+		begin
+			for (i = 0; i < 128; i = i+1) begin
+				z = 2285;   // 2^16 mod q
+				for (j = 0; j < brv(i, 7); j = j+1)
+					z = (z * 17) % KYBER_Q;
+				zetas[i] = z > KYBER_Q / 2 ? z - KYBER_Q : z;
+			end
+		end
+	endtask
+
+	task dilithium_zetas;
+		integer i, j;
+		reg [63:0] z;
+		begin
+			zetas[0] = 0;
+			for (i = 1; i < 256; i = i+1) begin
+				z = 4193792;   // 2^32 mod q
+				for (j = 0; j < brv(i, 8); j = j+1)
+					z = (z * 1753) % DILITHIUM_Q;
+				zetas[i] = z > DILITHIUM_Q / 2 ? z - DILITHIUM_Q : z;
+			end
+		end
+	endtask
+
+	task kyber_ntt;
+		integer len, start, j, k, t;
+		begin
+			k = 1;
+			for (len = 128; len >= 2; len = len >> 1) begin
+				for (start = 0; start < 256; start = j + len) begin
+					for (j = start; j < start + len; j = j+1) begin
+						t = kyber_fqmul(zetas[k], r[j + len]);
+						r[j + len] = sext16(r[j] - t);
+						r[j] = sext16(r[j] + t);
+					end
+					k = k + 1;
+				end
+			end
+		end
+	endtask
+
+	task kyber_invntt;
+		integer len, start, j, k, t;
+		begin
+			k = 127;
+			for (len = 2; len <= 128; len = len << 1) begin
+				for (start = 0; start < 256; start = j + len) begin
+					for (j = start; j < start + len; j = j+1) begin
+						t = r[j];
+						r[j] = kyber_barrett_reduce(t + r[j + len]);
+						r[j + len] = sext16(r[j + len] - t);
+						r[j + len] = kyber_fqmul(zetas[k], r[j + len]);
+					end
+					k = k - 1;
+				end
+			end
+			for (j = 0; j < 256; j = j+1)
+				r[j] = kyber_fqmul(r[j], 1441);
+		end
+	endtask
+
+	task dilithium_ntt;
+		integer len, start, j, k, t;
+		begin
+			k = 0;
+			for (len = 128; len > 0; len = len >> 1) begin
+				for (start = 0; start < 256; start = j + len) begin
+					k = k + 1;
+					for (j = start; j < start + len; j = j+1) begin
+						t = dilithium_fqmul(zetas[k], r[j + len]);
+						r[j + len] = r[j] - t;
+						r[j] = r[j] + t;
+					end
+				end
+			end
+		end
+	endtask
+
+	task dilithium_invntt_tomont;
+		integer len, start, j, k, t;
+		begin
+			k = 256;
+			for (len = 1; len < 256; len = len << 1) begin
+				for (start = 0; start < 256; start = j + len) begin
+					k = k - 1;
+					for (j = start; j < start + len; j = j+1) begin
+						t = r[j];
+						r[j] = t + r[j + len];
+						r[j + len] = t - r[j + len];
+						r[j + len] = dilithium_fqmul(-zetas[k], r[j + len]);
+					end
+				end
+			end
+			for (j = 0; j < 256; j = j+1)
+				r[j] = dilithium_fqmul(41978, r[j]);
+		end
+	endtask
+
+
+	// Engine access
+
+	integer errors;
+
+	task load_zetas;
+		input integer dilithium, len;
+		integer i;
+		begin
+			bus_write(13'h 1004, dilithium);
+			for (i = 0; i < len; i = i+1)
+				bus_write(13'h 0c00 + 4*i, zetas[i]);
+		end
+	endtask
+
+	task load_poly;
+		input integer n;
+		integer i;
+		begin
+			for (i = 0; i < 256; i = i+1)
+				bus_write(13'h 0400*n + 4*i, r[i]);
+		end
+	endtask
+
+	// run operation op on polynomial n and compare with r[]
+	task run_check;
+		input [8*24-1:0] name;
+		input integer op, n;
+		integer i;
+		reg [31:0] d;
+		begin
+			bus_write(13'h 1000, op | n << 4);
+			bus_read(13'h 1000, d);
+			for (i = 0; i < 256; i = i+1) begin
+				bus_read(13'h 0400*n + 4*i, d);
+				if (d !== r[i]) begin
+					if (errors < 10)
+						$display("ERROR: %0s: coefficient %1d is %1d, expected %1d", name, i, $signed(d), r[i]);
+					errors = errors + 1;
+				end
+			end
+			$display("%0s done.", name);
+		end
+	endtask
+
+	integer i, round;
+
+	initial begin
+		errors = 0;
+		repeat (5) @(posedge clk);
+		resetn <= 1;
+		@(posedge clk);
+		#1;
+
+		kyber_zetas;
+		load_zetas(0, 128);
+		for (round = 0; round < 2; round = round+1) begin
+			for (i = 0; i < 256; i = i+1)
+				r[i] = $random % KYBER_Q;
+			load_poly(round);
+			kyber_ntt;
+			run_check("kyber ntt", 1, round);
+			kyber_invntt;
+			run_check("kyber invntt", 2, round);
+		end
+
+		dilithium_zetas;
+		load_zetas(1, 256);
+		for (round = 0; round < 2; round = round+1) begin
+			for (i = 0; i < 256; i = i+1)
+				r[i] = $random % DILITHIUM_Q;
+			load_poly(2 - round);
+			dilithium_ntt;
+			run_check("dilithium ntt", 1, 2 - round);
+			dilithium_invntt_tomont;
+			run_check("dilithium invntt_tomont", 2, 2 - round);
+		end
+
+		// polynomial 3 does not exist, the command must be ignored
+		bus_write(13'h 1000, 1 | 3 << 4);
+		if (uut.busy) begin
+			$display("ERROR: command for polynomial 3 was accepted");
+			errors = errors + 1;
+		end
+
+		if (errors) begin
+			$display("%1d ERRORS.", errors);
+			$stop;
+		end
+		$display("ALL TESTS PASSED.");
+		$finish;
+	end
+endmodule
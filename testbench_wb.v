@@ -117,7 +117,9 @@ module picorv32_wrapper #(
 		.ENABLE_MUL(1),
 		.ENABLE_DIV(1),
 		.ENABLE_IRQ(1),
-		.ENABLE_TRACE(1)
+		.ENABLE_TRACE(1),
+		.ENABLE_AES32(1),
+		.ENABLE_ZBKB(1)
 `endif
 	) uut (
 		.trap (trap),